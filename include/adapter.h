@@ -3,19 +3,66 @@
 #pragma once
 
 #include <range.h>
+#include <algorithm.h>
+#include <algorithm>
 #include <functional>
 #include <tuple>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>	// for the AVX2 bloom_filter probe
+#endif
 
 namespace stdext
 {
+	// Byte order of the records read by record_view.
+	enum class byte_order
+	{
+		little,
+		big,
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		native = big
+#else
+		native = little
+#endif
+	};
+
 	template <class Range1, class Range2> class concatenated_range;
 	template <class Range, class Predicate> class filtered_range;
 	template <class Range, class Operation> class transformed_range;
 	template <class Range, class Predicate> class unique_range;
+	template <class Range> class distinct_range;
 	template <class Range> class reversed_range;
 	template <class Range> class rotated_range;
 	template <class Range, class Predicate> class partitioned_range;
+	class split_range;
+	template <class Record, byte_order Order> class record_range;
+	template <class Range> class strided_range;
+	template <class Range> class chunked_range;
+	template <class Range> class sliding_range;
+	template <class Range, class Compare> class merged_range;
+	template <class Range1, class Range2, class Operation, class Compare> class set_operation_range;
+	template <class Range, class Aggregator> class aggregated_range;
+	template <class T> class top_k_range;
+	template <class Row> class grouped_range;
+	template <class Range, class Predicate> class chunk_by_range;
+	template <class Range, class Aggregator> class reduced_range;
+	template <class BuildRange, class ProbeRange, class BuildKey, class ProbeKey> class hash_join_range;
+	template <class Range1, class Range2, class Key1, class Key2, class Compare> class merge_join_range;
+	template <class T, class Hash = ::std::hash<T>> class bloom_filter;
+	class count_aggregator;
+	template <class Operation> class sum_aggregator;
+	template <class Operation, class Compare> class min_aggregator;
+	template <class T, class Operation> class fold_aggregator;
+	template <class... Ranges> class zip_range;
+	template <class... References> class zip_reference;
 
 	namespace detail
 	{
@@ -33,10 +80,41 @@ namespace stdext
 		template <class Predicate, class T> struct range_replace_if_t;
 		struct range_unique_t;
 		template <class Predicate> struct range_unique_if_t;
+		struct range_distinct_t;
 		struct range_reverse_t;
 		struct range_rotate_t;
 		template <class T> struct range_partition_t;
 		template <class Predicate> struct range_partition_if_t;
+		struct range_split_t;
+		struct range_lines_t;
+		struct range_stride_t;
+		struct range_chunk_t;
+		struct range_sliding_t;
+		template <class Aggregator> struct range_window_aggregate_t;
+		template <class Predicate> struct range_chunk_by_t;
+		template <class KeyFunction> struct range_group_by_key_t;
+		template <class Aggregator> struct range_reduce_groups_t;
+		template <class Filter, class KeyFunction> struct range_semi_join_t;
+		struct range_semi_join_identity;
+
+		struct set_union_op;
+		struct set_intersection_op;
+		struct set_difference_op;
+		struct set_symmetric_difference_op;
+		template <class Range, class Operation, class Compare> struct range_set_operation_t;
+		template <class Compare> struct range_top_k_t;
+
+		template <class T> struct is_vector : ::std::false_type { };
+		template <class T, class Allocator> struct is_vector<::std::vector<T, Allocator>> : ::std::true_type { };
+
+		template <class Range, class KeyFunction>
+		using group_key_t = typename ::std::decay<decltype(::std::declval<KeyFunction&>()(::std::declval<typename range_traits<Range>::reference>()))>::type;
+		template <class Aggregator, class Reference>
+		using aggregate_state_t = decltype(::std::declval<const Aggregator&>().start(::std::declval<Reference>()));
+		template <class Aggregator, class Reference>
+		using aggregate_value_t = typename ::std::decay<decltype(::std::declval<const Aggregator&>().value(::std::declval<const aggregate_state_t<Aggregator, Reference>&>()))>::type;
+		template <class Range, class KeyFunction, class... Aggregators>
+		using group_row_t = ::std::tuple<group_key_t<Range, KeyFunction>, aggregate_value_t<Aggregators, typename range_traits<Range>::reference>...>;
 	}
 
 	template <class Range>     detail::range_prepend_t<Range>       prepend(Range&& r);
@@ -53,10 +131,64 @@ namespace stdext
 	template <class Predicate, class T> detail::range_replace_if_t<Predicate, T> replace_if(Predicate&& pred, T&& new_value);
 	                           detail::range_unique_t               unique();
 	template <class Predicate> detail::range_unique_if_t<Predicate> unique_if(Predicate&& pred);
+	                           detail::range_distinct_t             distinct();
+	                           detail::range_distinct_t             distinct(scratch_buffer& scratch);
 	                           detail::range_reverse_t              reverse();
 	                           detail::range_rotate_t               rotate(::std::ptrdiff_t n);
 	template <class T>         detail::range_partition_t<T>         partition(T&& value);
 	template <class Predicate> detail::range_partition_if_t<Predicate> partition_if(Predicate&& pred);
+	                           detail::range_split_t                split(char delim);
+	                           detail::range_lines_t                lines();
+
+	                           detail::range_stride_t               stride(::std::ptrdiff_t n);
+	                           detail::range_chunk_t                chunk(::std::ptrdiff_t n);
+	                           detail::range_sliding_t              sliding(::std::ptrdiff_t width);
+	template <class Aggregator> detail::range_window_aggregate_t<typename ::std::decay<Aggregator>::type> window_aggregate(::std::ptrdiff_t width, Aggregator&& agg);
+	template <class Predicate> detail::range_chunk_by_t<typename ::std::decay<Predicate>::type> chunk_by(Predicate&& pred);
+	template <class KeyFunction> detail::range_group_by_key_t<typename ::std::decay<KeyFunction>::type> group_by_key(KeyFunction&& key);
+	template <class Aggregator> detail::range_reduce_groups_t<typename ::std::decay<Aggregator>::type> reduce_groups(Aggregator&& agg);
+	template <class Filter>    detail::range_semi_join_t<Filter, detail::range_semi_join_identity> semi_join_filter(const Filter& filter);
+	template <class Filter, class KeyFunction> detail::range_semi_join_t<Filter, typename ::std::decay<KeyFunction>::type> semi_join_filter(const Filter& filter, KeyFunction&& key);
+	template <class Filter>    void semi_join_filter(const Filter&& filter) = delete;
+	template <class Filter, class KeyFunction> void semi_join_filter(const Filter&& filter, KeyFunction&& key) = delete;
+
+	template <class... Ranges> zip_range<typename ::std::decay<Ranges>::type...> zip(Ranges&&... ranges);
+	template <class Range, class Compare = ::std::less<>> detail::range_set_operation_t<typename ::std::decay<Range>::type, detail::set_union_op, Compare> union_with(Range&& range, Compare comp = Compare());
+	template <class Range, class Compare = ::std::less<>> detail::range_set_operation_t<typename ::std::decay<Range>::type, detail::set_intersection_op, Compare> intersect_with(Range&& range, Compare comp = Compare());
+	template <class Range, class Compare = ::std::less<>> detail::range_set_operation_t<typename ::std::decay<Range>::type, detail::set_difference_op, Compare> difference_with(Range&& range, Compare comp = Compare());
+	template <class Range, class Compare = ::std::less<>> detail::range_set_operation_t<typename ::std::decay<Range>::type, detail::set_symmetric_difference_op, Compare> symmetric_difference_with(Range&& range, Compare comp = Compare());
+	template <class Range, class Compare = ::std::less<>> merged_range<Range, Compare> merge_all(::std::vector<Range> ranges, Compare comp = Compare());
+	template <class Range1, class Range2, class... Ranges>
+	typename ::std::enable_if<!detail::is_vector<typename ::std::decay<Range1>::type>::value, merged_range<typename ::std::decay<Range1>::type, ::std::less<>>>::type
+		merge_all(Range1&& range1, Range2&& range2, Ranges&&... ranges);
+	template <class BuildRange, class ProbeRange, class BuildKey, class ProbeKey>
+	hash_join_range<typename ::std::decay<BuildRange>::type, typename ::std::decay<ProbeRange>::type, BuildKey, ProbeKey>
+		join_hash(BuildRange&& build, ProbeRange&& probe, BuildKey build_key, ProbeKey probe_key);
+	template <class Range1, class Range2, class Key1, class Key2, class Compare = ::std::less<>>
+	merge_join_range<typename ::std::decay<Range1>::type, typename ::std::decay<Range2>::type, Key1, Key2, Compare>
+		join_merge(Range1&& range1, Range2&& range2, Key1 key1, Key2 key2, Compare comp = Compare());
+	template <class Compare = ::std::less<>> detail::range_top_k_t<Compare> top_k(::std::size_t k, Compare comp = Compare());
+
+	                           count_aggregator                     group_count();
+	template <class Operation> sum_aggregator<Operation>            group_sum(Operation op);
+	template <class Operation> min_aggregator<Operation, ::std::less<>> group_min(Operation op);
+	template <class Operation> min_aggregator<Operation, ::std::greater<>> group_max(Operation op);
+	template <class T, class Operation> fold_aggregator<T, Operation> group_fold(T init, Operation op);
+	template <class Range, class KeyFunction, class... Aggregators>
+	grouped_range<detail::group_row_t<Range, KeyFunction, Aggregators...>> group_aggregate(const Range& range, KeyFunction key, Aggregators... aggs);
+	template <class Range, class KeyFunction, class... Aggregators>
+	grouped_range<detail::group_row_t<Range, KeyFunction, Aggregators...>> group_aggregate(const Range& range, KeyFunction key, scratch_buffer& scratch, Aggregators... aggs);
+	template <class Range, class KeyFunction, class... Aggregators>
+	grouped_range<detail::group_row_t<Range, KeyFunction, Aggregators...>> parallel_group_aggregate(const Range& range, KeyFunction key, Aggregators... aggs);
+	template <class ForwardRange>
+	bloom_filter<typename ::std::remove_cv<typename range_traits<ForwardRange>::value_type>::type> make_bloom_filter(const ForwardRange& keys);
+	template <class ForwardRange, class KeyFunction>
+	bloom_filter<detail::group_key_t<ForwardRange, KeyFunction>> make_bloom_filter(const ForwardRange& range, KeyFunction key);
+
+	template <class Record, byte_order Order, class ByteRange> record_range<Record, Order> record_view(const ByteRange& bytes);
+	template <class Record, class ByteRange> record_range<Record, byte_order::native> record_view(const ByteRange& bytes);
+	template <class T> typename ::std::enable_if<::std::is_arithmetic<T>::value || ::std::is_enum<T>::value>::type swap_record_bytes(T& value) noexcept;
+	template <class T, ::std::size_t N> void swap_record_bytes(T (&values)[N]) noexcept;
 
 	namespace detail
 	{
@@ -110,6 +242,7 @@ namespace stdext
 
 		struct range_unique_t { };
 		template <class Predicate> struct range_unique_if_t { Predicate pred; };
+		struct range_distinct_t { scratch_buffer* scratch; };
 		struct range_reverse_t { };
 		struct range_rotate_t { ::std::ptrdiff_t n; };
 
@@ -123,6 +256,37 @@ namespace stdext
 		};
 
 		template <class Predicate> struct range_partition_if_t { Predicate pred; };
+
+		struct range_split_t { char delim; };
+		struct range_lines_t { };
+		struct range_stride_t { ::std::ptrdiff_t n; };
+		struct range_chunk_t { ::std::ptrdiff_t n; };
+		struct range_sliding_t { ::std::ptrdiff_t width; };
+		template <class Aggregator> struct range_window_aggregate_t { ::std::ptrdiff_t width; Aggregator agg; };
+		template <class Predicate> struct range_chunk_by_t { Predicate pred; };
+		template <class KeyFunction> struct range_group_by_key_t { KeyFunction key; };
+		template <class KeyFunction> struct range_group_by_key_op
+		{
+			template <class T1, class T2>
+			bool operator () (const T1& a, const T2& b) const { return key(a) == key(b); }
+			KeyFunction key;
+		};
+		template <class Aggregator> struct range_reduce_groups_t { Aggregator agg; };
+		template <class Filter, class KeyFunction> struct range_semi_join_t { const Filter* filter; KeyFunction key; };
+		template <class Filter, class KeyFunction> struct range_semi_join_op
+		{
+			template <class T>
+			bool operator () (const T& value) const { return filter->may_contain(key(value)); }
+			const Filter* filter;
+			KeyFunction key;
+		};
+		struct range_semi_join_identity
+		{
+			template <class T>
+			const T& operator () (const T& value) const { return value; }
+		};
+		template <class Range, class Operation, class Compare> struct range_set_operation_t { Range r; Compare comp; };
+		template <class Compare> struct range_top_k_t { ::std::size_t k; Compare comp; };
 	}
 
 	template <class Range1, class Range2>
@@ -155,6 +319,8 @@ namespace stdext
 	template <class Range, class Predicate>
 	unique_range<Range, Predicate> operator >> (Range&& range, detail::range_unique_if_t<Predicate>&& unique);
 	template <class Range>
+	distinct_range<typename ::std::decay<Range>::type> operator >> (Range&& range, const detail::range_distinct_t& distinct);
+	template <class Range>
 	reversed_range<Range> operator >> (Range&& range, detail::range_reverse_t&& reverse);
 	template <class Range>
 	rotated_range<Range> operator >> (Range&& range, detail::range_rotate_t&& rotate);
@@ -162,6 +328,31 @@ namespace stdext
 	partitioned_range<Range, detail::range_partition_op<T>> operator >> (Range&& range, detail::range_partition_t<T>&& partition);
 	template <class Range, class Predicate>
 	partitioned_range<Range, Predicate> operator >> (Range&& range, detail::range_partition_if_t<Predicate>&& partition);
+	template <class Range>
+	split_range operator >> (Range&& range, const detail::range_split_t& split);
+	template <class Range>
+	split_range operator >> (Range&& range, const detail::range_lines_t& lines);
+	template <class Range>
+	strided_range<Range> operator >> (Range&& range, const detail::range_stride_t& stride);
+	template <class Range>
+	chunked_range<Range> operator >> (Range&& range, const detail::range_chunk_t& chunk);
+	template <class Range>
+	sliding_range<Range> operator >> (Range&& range, const detail::range_sliding_t& sliding);
+	template <class Range, class Aggregator>
+	aggregated_range<Range, Aggregator> operator >> (Range&& range, detail::range_window_aggregate_t<Aggregator>&& aggregate);
+	template <class Range, class Predicate>
+	chunk_by_range<typename ::std::decay<Range>::type, Predicate> operator >> (Range&& range, detail::range_chunk_by_t<Predicate>&& chunk);
+	template <class Range, class KeyFunction>
+	chunk_by_range<typename ::std::decay<Range>::type, detail::range_group_by_key_op<KeyFunction>> operator >> (Range&& range, detail::range_group_by_key_t<KeyFunction>&& group);
+	template <class Range, class Aggregator>
+	reduced_range<typename ::std::decay<Range>::type, Aggregator> operator >> (Range&& range, detail::range_reduce_groups_t<Aggregator>&& reduce);
+	template <class Range, class Filter, class KeyFunction>
+	filtered_range<typename ::std::decay<Range>::type, detail::range_semi_join_op<Filter, KeyFunction>> operator >> (Range&& range, detail::range_semi_join_t<Filter, KeyFunction>&& semi_join);
+	template <class Range1, class Range2, class Operation, class Compare>
+	set_operation_range<typename ::std::decay<Range1>::type, Range2, Operation, Compare> operator >> (Range1&& range1, detail::range_set_operation_t<Range2, Operation, Compare>&& operation);
+	template <class Range, class Compare>
+	top_k_range<typename ::std::remove_cv<typename range_traits<typename ::std::decay<Range>::type>::value_type>::type>
+		operator >> (Range&& range, detail::range_top_k_t<Compare>&& top);
 
 	////////////////////////////////////////////////////////////////
 	// concatenated_range
@@ -397,7 +588,7 @@ namespace stdext
 	public:
 		filtered_range(InputRange range, Predicate pred) : range(::std::move(range)), pred(::std::move(pred))
 		{
-			while (!empty(this->range) && !pred(front(this->range)))
+			while (!empty(this->range) && !this->pred(front(this->range)))
 				drop_first(this->range);
 		}
 
@@ -450,7 +641,7 @@ namespace stdext
 
 			using transformed_range_base<Range, InputRange, Operation, Category, input_range_tag>::end_pos;
 			void end_pos(position_type p) { this->self().range.end_pos(::std::move(p)); }
-			difference_type distance_pos(position_type p1, position_type p2) { return this->self().range.distance_pos(p1, p2); }
+			difference_type distance_pos(position_type p1, position_type p2) const { return this->self().range.distance_pos(p1, p2); }
 		};
 
 		template <class Range, class InputRange, class Operation, class Category>
@@ -458,7 +649,7 @@ namespace stdext
 			: transformed_range_base<Range, InputRange, Operation, Category, forward_range_tag>
 		{
 			typedef typename range_traits<transformed_range_base>::position_type position_type;
-			position_type& decrement_pos(position_type& p) { return this->self().range.decrement_pos(p); }
+			position_type& decrement_pos(position_type& p) const { return this->self().range.decrement_pos(p); }
 		};
 
 		template <class Range, class InputRange, class Operation, class Category>
@@ -587,6 +778,56 @@ namespace stdext
 		Predicate pred;
 	};
 
+	////////////////////////////////////////////////////////////////
+	// distinct_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		template <class T> class distinct_set;
+	}
+
+	// The elements of a range that are not equal to an earlier element, in their original order.
+	// Unlike unique, duplicates need not be adjacent: the values yielded so far are kept in a hash
+	// table, carved from the scratch buffer given to distinct while it has room and then from the
+	// heap, so the range can be read only once.  Copies of the range share the table.
+	template <class InputRange>
+	class distinct_range : public range<input_range_tag,
+		typename range_traits<InputRange>::value_type,
+		typename range_traits<InputRange>::position_type,
+		typename range_traits<InputRange>::difference_type,
+		typename range_traits<InputRange>::reference>
+	{
+	public:
+		typedef typename range_traits<distinct_range>::position_type position_type;
+		typedef typename range_traits<distinct_range>::reference reference;
+		typedef typename ::std::remove_cv<typename range_traits<distinct_range>::value_type>::type value_type;
+
+	public:
+		distinct_range(InputRange range, scratch_buffer* scratch)
+			: range(::std::move(range)), seen(::std::make_shared<detail::distinct_set<value_type>>(scratch))
+		{
+			if (this->range.begin_pos() != this->range.end_pos())
+				seen->insert(this->range.at_pos(this->range.begin_pos()));
+		}
+
+	public:
+		position_type  begin_pos() const                     { return range.begin_pos(); }
+		void           begin_pos(position_type p)            { range.begin_pos(::std::move(p)); }
+		position_type  end_pos() const                       { return range.end_pos(); }
+		reference      at_pos(const position_type& p) const  { return range.at_pos(p); }
+		position_type& increment_pos(position_type& p) const
+		{
+			do {
+				range.increment_pos(p);
+			} while (p != range.end_pos() && !seen->insert(range.at_pos(p)));
+			return p;
+		}
+
+	private:
+		InputRange range;
+		::std::shared_ptr<detail::distinct_set<value_type>> seen;
+	};
+
 	namespace detail
 	{
 		template <class Range, class BidirectionalRange, class Category, class BaseCategory = Category>
@@ -886,6 +1127,1799 @@ namespace stdext
 		Predicate pred;
 		position_type first, last;
 	};
+
+	////////////////////////////////////////////////////////////////
+	// split_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		// A split position identifies a single token [first, last) in the underlying character
+		// sequence; last points either at the delimiter that ends the token or at the end of the
+		// sequence.  The end position is represented by a pair of null pointers.
+		struct split_position
+		{
+			const char* first;
+			const char* last;
+		};
+
+		inline bool operator == (const split_position& a, const split_position& b) noexcept { return a.first == b.first && a.last == b.last; }
+		inline bool operator != (const split_position& a, const split_position& b) noexcept { return !(a == b); }
+
+		const char* find_delimiter(const char* first, const char* last, char delim) noexcept;
+	}
+
+	// Splits a contiguous character sequence into tokens separated by a delimiter.  Tokens are
+	// yielded as iterator_range<const char*> referring directly into the sequence; nothing is
+	// copied.  In lines mode, the delimiter is '\n', a trailing '\r' is removed from each token,
+	// and a final newline does not produce an empty trailing token.
+	class split_range
+		: public range<forward_range_tag, iterator_range<const char*>, detail::split_position, ::std::ptrdiff_t, iterator_range<const char*>>
+	{
+	public:
+		typedef typename range_traits<split_range>::position_type position_type;
+		typedef typename range_traits<split_range>::reference reference;
+		typedef typename range_traits<split_range>::difference_type difference_type;
+
+	public:
+		split_range() : last_char(nullptr), delim('\n'), lines(false), first(), last() { }
+		split_range(const char* first_char, const char* last_char, char delim, bool lines = false)
+			: last_char(last_char), delim(delim), lines(lines), first(), last()
+		{
+			if (first_char != last_char)
+				first = { first_char, detail::find_delimiter(first_char, last_char, delim) };
+		}
+
+	public:
+		position_type  begin_pos() const noexcept           { return first; }
+		void           begin_pos(position_type p) noexcept  { first = p; }
+		position_type  end_pos() const noexcept             { return last; }
+		void           end_pos(position_type p) noexcept    { last = p; }
+		reference      at_pos(const position_type& p) const
+		{
+			auto token_last = p.last;
+			if (lines && token_last != p.first && token_last[-1] == '\r')
+				--token_last;
+			return reference(p.first, token_last);
+		}
+		position_type& increment_pos(position_type& p) const
+		{
+			if (p.last == last_char || (lines && p.last + 1 == last_char))
+				return p = position_type();
+
+			p.first = p.last + 1;
+			p.last = detail::find_delimiter(p.first, last_char, delim);
+			return p;
+		}
+		difference_type distance_pos(position_type p1, position_type p2) const
+		{
+			difference_type distance = 0;
+			while (p1 != p2)
+			{
+				increment_pos(p1);
+				++distance;
+			}
+
+			return distance;
+		}
+
+	private:
+		const char* last_char;
+		char delim;
+		bool lines;
+		position_type first, last;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// record_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		template <class T>
+		T load_record(const unsigned char* p, ::std::false_type /* swap */) noexcept
+		{
+			typename ::std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+			::std::memcpy(&storage, p, sizeof(T));
+			return *reinterpret_cast<const T*>(&storage);
+		}
+
+		template <class T>
+		T load_record(const unsigned char* p, ::std::true_type /* swap */) noexcept
+		{
+			using ::stdext::swap_record_bytes;
+			T value = load_record<T>(p, ::std::false_type());
+			swap_record_bytes(value);
+			return value;
+		}
+	}
+
+	// Presents a contiguous sequence of bytes as a sequence of packed, fixed-size records.  Each
+	// record is loaded by value with memcpy, so the underlying bytes need not be suitably aligned
+	// for Record, and no Record constructor is ever run.  Trailing bytes that do not form a
+	// complete record are ignored.
+	//
+	// If Order differs from the native byte order, each record is converted as it is loaded by
+	// calling swap_record_bytes(record), found by argument-dependent lookup.  stdext provides it
+	// for arithmetic and enumeration types and for arrays of those; for a struct record, define
+	// swap_record_bytes(Record&) in the record's namespace to swap each field in turn:
+	//
+	//     void swap_record_bytes(trade& t) noexcept
+	//     {
+	//         using stdext::swap_record_bytes;
+	//         swap_record_bytes(t.id);
+	//         swap_record_bytes(t.price);
+	//     }
+	template <class Record, byte_order Order>
+	class record_range
+		: public range<random_access_range_tag, Record, const unsigned char*, ::std::ptrdiff_t, Record>
+	{
+		static_assert(::std::is_trivially_copyable<Record>::value, "stdext::record_range: Record must be trivially copyable");
+
+	public:
+		typedef typename range_traits<record_range>::position_type position_type;
+		typedef typename range_traits<record_range>::reference reference;
+		typedef typename range_traits<record_range>::difference_type difference_type;
+
+	public:
+		record_range() : first(nullptr), last(nullptr) { }
+		record_range(const void* first_byte, ::std::size_t size)
+			: first(static_cast<const unsigned char*>(first_byte))
+			, last(first + size / sizeof(Record) * sizeof(Record))
+		{
+		}
+
+	public:
+		position_type  begin_pos() const noexcept                             { return first; }
+		void           begin_pos(position_type p) noexcept                    { first = p; }
+		position_type  end_pos() const noexcept                               { return last; }
+		void           end_pos(position_type p) noexcept                      { last = p; }
+		reference      at_pos(const position_type& p) const noexcept
+		{
+			return detail::load_record<Record>(p, ::std::integral_constant<bool, Order != byte_order::native>());
+		}
+		position_type& increment_pos(position_type& p) const noexcept         { return p += sizeof(Record); }
+		position_type& decrement_pos(position_type& p) const noexcept         { return p -= sizeof(Record); }
+		position_type& advance_pos(position_type& p, difference_type n) const noexcept { return p += n * difference_type(sizeof(Record)); }
+		difference_type distance_pos(position_type p1, position_type p2) const noexcept  { return (p2 - p1) / difference_type(sizeof(Record)); }
+
+	private:
+		position_type first, last;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// strided_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		template <class Range, class InputRange, class Category, class BaseCategory = Category>
+		struct strided_range_base;
+
+		template <class Range, class InputRange, class Category>
+		struct strided_range_base<Range, InputRange, Category, input_range_tag>
+			: range<Category,
+				typename range_traits<InputRange>::value_type,
+				typename range_traits<InputRange>::position_type,
+				typename range_traits<InputRange>::difference_type,
+				typename range_traits<InputRange>::reference>
+		{
+			typedef typename range_traits<strided_range_base>::position_type position_type;
+			typedef typename range_traits<strided_range_base>::reference reference;
+			typedef typename range_traits<strided_range_base>::difference_type difference_type;
+
+			// range requirements
+			position_type  begin_pos() const                     { return self().range.begin_pos(); }
+			void           begin_pos(position_type p)            { self().range.begin_pos(::std::move(p)); }
+			position_type  end_pos() const                       { return self().range.end_pos(); }
+			reference      at_pos(const position_type& p) const  { return self().range.at_pos(p); }
+			position_type& increment_pos(position_type& p) const
+			{
+				auto p_last = self().range.end_pos();
+				for (difference_type n = self().step; n != 0 && p != p_last; --n)
+					self().range.increment_pos(p);
+				return p;
+			}
+
+		protected:
+			Range& self() { return static_cast<Range&>(*this); }
+			const Range& self() const { return static_cast<const Range&>(*this); }
+		};
+
+		template <class Range, class InputRange, class Category>
+		struct strided_range_base<Range, InputRange, Category, forward_range_tag>
+			: strided_range_base<Range, InputRange, Category, input_range_tag>
+		{
+			typedef typename range_traits<strided_range_base>::position_type position_type;
+			typedef typename range_traits<strided_range_base>::difference_type difference_type;
+
+			using strided_range_base<Range, InputRange, Category, input_range_tag>::end_pos;
+			void end_pos(position_type p) { this->self().range.end_pos(::std::move(p)); }
+			difference_type distance_pos(position_type p1, position_type p2) const
+			{
+				difference_type distance = 0;
+				while (p1 != p2)
+				{
+					this->increment_pos(p1);
+					++distance;
+				}
+
+				return distance;
+			}
+		};
+
+		template <class Range, class InputRange, class Category>
+		struct strided_range_base<Range, InputRange, Category, bidirectional_range_tag>
+			: strided_range_base<Range, InputRange, Category, forward_range_tag>
+		{
+			typedef typename range_traits<strided_range_base>::position_type position_type;
+			typedef typename range_traits<strided_range_base>::difference_type difference_type;
+
+			// Stepping back from the end lands on the last selected element, which depends on the
+			// length of the underlying range.  Without random access, that costs a full traversal.
+			position_type& decrement_pos(position_type& p) const
+			{
+				auto n = this->self().step;
+				if (p == this->self().range.end_pos())
+				{
+					auto remainder = length(this->self().range) % n;
+					if (remainder != 0)
+						n = remainder;
+				}
+
+				while (n-- > 0)
+					this->self().range.decrement_pos(p);
+				return p;
+			}
+		};
+
+		template <class Range, class InputRange, class Category>
+		struct strided_range_base<Range, InputRange, Category, random_access_range_tag>
+			: strided_range_base<Range, InputRange, Category, bidirectional_range_tag>
+		{
+			typedef typename range_traits<strided_range_base>::position_type position_type;
+			typedef typename range_traits<strided_range_base>::difference_type difference_type;
+
+			position_type& increment_pos(position_type& p) const
+			{
+				return advance_pos(p, 1);
+			}
+
+			position_type& decrement_pos(position_type& p) const
+			{
+				return advance_pos(p, -1);
+			}
+
+			position_type& advance_pos(position_type& p, difference_type n) const
+			{
+				const auto& range = this->self().range;
+				auto step = this->self().step;
+				if (n >= 0)
+				{
+					// Clamp to the end of the underlying range rather than stepping past it.
+					auto d = range.distance_pos(p, range.end_pos());
+					return range.advance_pos(p, n * step < d ? n * step : d);
+				}
+
+				auto remainder = range.distance_pos(range.begin_pos(), p) % step;
+				if (remainder != 0)
+					return range.advance_pos(p, -(remainder + (-n - 1) * step));
+				return range.advance_pos(p, n * step);
+			}
+
+			difference_type distance_pos(position_type p1, position_type p2) const
+			{
+				auto step = this->self().step;
+				auto d = this->self().range.distance_pos(p1, p2);
+				return d >= 0 ? (d + step - 1) / step : -((-d + step - 1) / step);
+			}
+		};
+	}
+
+	// Visits every n-th element of the underlying range, starting with the first; n must be
+	// positive.  Over random access ranges, all position operations are O(1).
+	template <class InputRange>
+	class strided_range : public detail::strided_range_base<strided_range<InputRange>, InputRange, typename range_traits<InputRange>::range_category>
+	{
+	public:
+		strided_range(InputRange range, ::std::ptrdiff_t step) : range(::std::move(range)), step(step)
+		{
+			if (step <= 0)
+				throw ::std::domain_error("stride must be positive");
+		}
+
+	private:
+		typedef typename range_traits<InputRange>::range_category category;
+		friend struct detail::strided_range_base<strided_range, InputRange, category, input_range_tag>;
+		friend struct detail::strided_range_base<strided_range, InputRange, category, forward_range_tag>;
+		friend struct detail::strided_range_base<strided_range, InputRange, category, bidirectional_range_tag>;
+		friend struct detail::strided_range_base<strided_range, InputRange, category, random_access_range_tag>;
+
+		InputRange range;
+		typename range_traits<InputRange>::difference_type step;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// chunked_range
+	////////////////////////////////////////////////////////////////
+
+	// Splits the underlying range into consecutive subranges of n elements, where n must be
+	// positive; the last subrange may be shorter.  A chunk begins at every n-th position, so
+	// chunked_range traverses the underlying range exactly as strided_range does, but each
+	// element is the subrange that starts at that position.  Over random access ranges, the
+	// number of chunks and any individual chunk can be computed in O(1).
+	template <class ForwardRange>
+	class chunked_range : public detail::strided_range_base<chunked_range<ForwardRange>, ForwardRange, typename range_traits<ForwardRange>::range_category>
+	{
+		static_assert(is_forward_range<ForwardRange>::value, "stdext::chunked_range: underlying range is not a forward range");
+
+	public:
+		typedef ForwardRange value_type;
+		typedef ForwardRange reference;
+		typedef typename range_traits<ForwardRange>::position_type position_type;
+
+	public:
+		chunked_range(ForwardRange range, ::std::ptrdiff_t step) : range(::std::move(range)), step(step)
+		{
+			if (step <= 0)
+				throw ::std::domain_error("chunk size must be positive");
+		}
+
+	public:
+		reference at_pos(const position_type& p) const
+		{
+			auto last = p;
+			this->increment_pos(last);
+			return range_before(range_after(range, p), last);
+		}
+
+	private:
+		typedef typename range_traits<ForwardRange>::range_category category;
+		friend struct detail::strided_range_base<chunked_range, ForwardRange, category, input_range_tag>;
+		friend struct detail::strided_range_base<chunked_range, ForwardRange, category, forward_range_tag>;
+		friend struct detail::strided_range_base<chunked_range, ForwardRange, category, bidirectional_range_tag>;
+		friend struct detail::strided_range_base<chunked_range, ForwardRange, category, random_access_range_tag>;
+
+		ForwardRange range;
+		typename range_traits<ForwardRange>::difference_type step;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// zip_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		template <class F, ::std::size_t... I>
+		void for_each_index(F&& f, ::std::index_sequence<I...>)
+		{
+			int expand[] = { 0, (f(::std::integral_constant<::std::size_t, I>()), 0)... };
+			(void)expand;
+		}
+
+		// Positions are equal when all of their components are.  A zip_range keeps its positions
+		// aligned with its end position, either by trimming the zipped ranges to a common length on
+		// construction or by replacing a position that reaches the end of any zipped range with the
+		// end position.
+		template <class... Positions>
+		struct zip_position : ::std::tuple<Positions...>
+		{
+			using ::std::tuple<Positions...>::tuple;
+
+			friend bool operator == (const zip_position& a, const zip_position& b)
+			{
+				bool equal = true;
+				for_each_index([&](auto i) { equal = equal && ::std::get<decltype(i)::value>(a) == ::std::get<decltype(i)::value>(b); },
+					::std::index_sequence_for<Positions...>());
+				return equal;
+			}
+			friend bool operator != (const zip_position& a, const zip_position& b) { return !(a == b); }
+			friend bool operator < (const zip_position& a, const zip_position& b) { return ::std::get<0>(a) < ::std::get<0>(b); }
+		};
+	}
+
+	// The reference type of a zip_range: a tuple of references to the corresponding elements of
+	// each zipped range.  Assigning to a zip_reference assigns through to the referenced elements,
+	// and swapping two zip_references swaps the elements, so algorithms such as sort permute all of
+	// the zipped ranges together.
+	template <class... References>
+	class zip_reference : public ::std::tuple<References...>
+	{
+		typedef ::std::tuple<References...> base;
+
+	public:
+		using base::base;
+		using base::operator=;
+		zip_reference(const zip_reference&) = default;
+		zip_reference(zip_reference&&) = default;
+
+		zip_reference& operator = (const zip_reference& other)
+		{
+			base::operator=(other);
+			return *this;
+		}
+
+		zip_reference& operator = (zip_reference&& other)
+		{
+			detail::for_each_index([&](auto i) { ::std::get<decltype(i)::value>(*this) = ::std::move(::std::get<decltype(i)::value>(other)); },
+				::std::index_sequence_for<References...>());
+			return *this;
+		}
+
+		friend void swap(zip_reference&& a, zip_reference&& b)
+		{
+			detail::for_each_index([&](auto i) { using ::std::swap; swap(::std::get<decltype(i)::value>(a), ::std::get<decltype(i)::value>(b)); },
+				::std::index_sequence_for<References...>());
+		}
+		friend void swap(zip_reference& a, zip_reference& b) { swap(::std::move(a), ::std::move(b)); }
+	};
+
+	namespace detail
+	{
+		template <class Range, class InputRanges, class Category, class BaseCategory = Category>
+		struct zip_range_base;
+
+		template <class Range, class... InputRanges, class Category>
+		struct zip_range_base<Range, ::std::tuple<InputRanges...>, Category, input_range_tag>
+			: range<Category,
+				::std::tuple<typename range_traits<InputRanges>::value_type...>,
+				zip_position<typename range_traits<InputRanges>::position_type...>,
+				::std::ptrdiff_t,
+				zip_reference<typename range_traits<InputRanges>::reference...>>
+		{
+			typedef typename range_traits<zip_range_base>::position_type position_type;
+			typedef typename range_traits<zip_range_base>::reference reference;
+
+			// range requirements
+			position_type  begin_pos() const
+			{
+				position_type p = get_pos([](const auto& r) { return r.begin_pos(); }, indices());
+				return align_end(p, trimmed());
+			}
+			void           begin_pos(position_type p)            { for_each_index([&](auto i) { this->zipped<decltype(i)::value>().begin_pos(::std::get<decltype(i)::value>(p)); }, indices()); }
+			position_type  end_pos() const                       { return get_pos([](const auto& r) { return r.end_pos(); }, indices()); }
+			reference      at_pos(const position_type& p) const  { return at_pos(p, indices()); }
+			position_type& increment_pos(position_type& p) const
+			{
+				for_each_index([&](auto i) { this->zipped<decltype(i)::value>().increment_pos(::std::get<decltype(i)::value>(p)); }, indices());
+				return align_end(p, trimmed());
+			}
+
+		protected:
+			typedef ::std::index_sequence_for<InputRanges...> indices;
+			// Bidirectional and random access ranges are trimmed to a common length on construction.
+			typedef typename ::std::is_convertible<Category, bidirectional_range_tag>::type trimmed;
+
+			Range& self() noexcept { return static_cast<Range&>(*this); }
+			const Range& self() const noexcept { return static_cast<const Range&>(*this); }
+
+			template <::std::size_t I> auto& zipped() noexcept { return ::std::get<I>(self().ranges); }
+			template <::std::size_t I> const auto& zipped() const noexcept { return ::std::get<I>(self().ranges); }
+
+		private:
+			template <class F, ::std::size_t... I>
+			position_type get_pos(F f, ::std::index_sequence<I...>) const { return position_type(f(zipped<I>())...); }
+
+			template <::std::size_t... I>
+			reference at_pos(const position_type& p, ::std::index_sequence<I...>) const { return reference(zipped<I>().at_pos(::std::get<I>(p))...); }
+
+			position_type& align_end(position_type& p, ::std::true_type /* trimmed */) const noexcept { return p; }
+			position_type& align_end(position_type& p, ::std::false_type /* trimmed */) const
+			{
+				bool at_end = false;
+				for_each_index([&](auto i) { at_end = at_end || ::std::get<decltype(i)::value>(p) == this->zipped<decltype(i)::value>().end_pos(); }, indices());
+				if (at_end)
+					p = end_pos();
+				return p;
+			}
+		};
+
+		template <class Range, class... InputRanges, class Category>
+		struct zip_range_base<Range, ::std::tuple<InputRanges...>, Category, forward_range_tag>
+			: zip_range_base<Range, ::std::tuple<InputRanges...>, Category, input_range_tag>
+		{
+			typedef typename range_traits<zip_range_base>::position_type position_type;
+			typedef typename range_traits<zip_range_base>::difference_type difference_type;
+
+			using zip_range_base<Range, ::std::tuple<InputRanges...>, Category, input_range_tag>::end_pos;
+			void end_pos(position_type p)
+			{
+				for_each_index([&](auto i) { this->template zipped<decltype(i)::value>().end_pos(::std::get<decltype(i)::value>(p)); }, typename zip_range_base::indices());
+			}
+
+			// The distance to the end of the shortest range is the smallest of the distances.
+			difference_type distance_pos(position_type p1, position_type p2) const
+			{
+				difference_type distance = this->template zipped<0>().distance_pos(::std::get<0>(p1), ::std::get<0>(p2));
+				for_each_index([&](auto i) {
+					difference_type d = this->template zipped<decltype(i)::value>().distance_pos(::std::get<decltype(i)::value>(p1), ::std::get<decltype(i)::value>(p2));
+					if (d < distance)
+						distance = d;
+				}, typename zip_range_base::indices());
+				return distance;
+			}
+		};
+
+		template <class Range, class... InputRanges, class Category>
+		struct zip_range_base<Range, ::std::tuple<InputRanges...>, Category, bidirectional_range_tag>
+			: zip_range_base<Range, ::std::tuple<InputRanges...>, Category, forward_range_tag>
+		{
+			typedef typename range_traits<zip_range_base>::position_type position_type;
+
+			position_type& decrement_pos(position_type& p) const
+			{
+				for_each_index([&](auto i) { this->template zipped<decltype(i)::value>().decrement_pos(::std::get<decltype(i)::value>(p)); }, typename zip_range_base::indices());
+				return p;
+			}
+		};
+
+		template <class Range, class... InputRanges, class Category>
+		struct zip_range_base<Range, ::std::tuple<InputRanges...>, Category, random_access_range_tag>
+			: zip_range_base<Range, ::std::tuple<InputRanges...>, Category, bidirectional_range_tag>
+		{
+			typedef typename range_traits<zip_range_base>::position_type position_type;
+			typedef typename range_traits<zip_range_base>::difference_type difference_type;
+
+			position_type& advance_pos(position_type& p, difference_type n) const
+			{
+				for_each_index([&](auto i) { this->template zipped<decltype(i)::value>().advance_pos(::std::get<decltype(i)::value>(p), n); }, typename zip_range_base::indices());
+				return p;
+			}
+
+			// Random access ranges are trimmed to a common length on construction, so all components
+			// are the same distance apart.
+			difference_type distance_pos(position_type p1, position_type p2) const
+			{
+				return this->template zipped<0>().distance_pos(::std::get<0>(p1), ::std::get<0>(p2));
+			}
+		};
+
+		template <class... InputRanges>
+		void trim_to_shortest(::std::tuple<InputRanges...>& ranges, random_access_range_tag)
+		{
+			auto n = length(::std::get<0>(ranges));
+			for_each_index([&](auto i) {
+				auto d = length(::std::get<decltype(i)::value>(ranges));
+				if (d < n)
+					n = d;
+			}, ::std::index_sequence_for<InputRanges...>());
+			for_each_index([&](auto i) {
+				auto& r = ::std::get<decltype(i)::value>(ranges);
+				auto p = r.begin_pos();
+				r.end_pos(r.advance_pos(p, n));
+			}, ::std::index_sequence_for<InputRanges...>());
+		}
+
+		template <class... InputRanges, ::std::size_t... I>
+		auto begin_positions(const ::std::tuple<InputRanges...>& ranges, ::std::index_sequence<I...>)
+		{
+			return ::std::make_tuple(::std::get<I>(ranges).begin_pos()...);
+		}
+
+		// Bidirectional ranges are walked in lockstep to the end of the shortest one, which takes
+		// time proportional to its length.
+		template <class... InputRanges>
+		void trim_to_shortest(::std::tuple<InputRanges...>& ranges, bidirectional_range_tag)
+		{
+			auto p = begin_positions(ranges, ::std::index_sequence_for<InputRanges...>());
+			for (;;)
+			{
+				bool at_end = false;
+				for_each_index([&](auto i) { at_end = at_end || ::std::get<decltype(i)::value>(p) == ::std::get<decltype(i)::value>(ranges).end_pos(); },
+					::std::index_sequence_for<InputRanges...>());
+				if (at_end)
+					break;
+				for_each_index([&](auto i) { ::std::get<decltype(i)::value>(ranges).increment_pos(::std::get<decltype(i)::value>(p)); },
+					::std::index_sequence_for<InputRanges...>());
+			}
+			for_each_index([&](auto i) { ::std::get<decltype(i)::value>(ranges).end_pos(::std::get<decltype(i)::value>(p)); },
+				::std::index_sequence_for<InputRanges...>());
+		}
+
+		template <class... InputRanges>
+		void trim_to_shortest(::std::tuple<InputRanges...>&, input_range_tag)
+		{
+		}
+	}
+
+	// Traverses several ranges in lockstep.  Positions are tuples of the positions of the zipped
+	// ranges, and references are tuples of their references.  The category is the weakest of the
+	// categories of the zipped ranges, and traversal ends at the end of the shortest range.  Zipped
+	// bidirectional ranges are trimmed to the length of the shortest when the zip_range is built,
+	// so that decrementing its end position reaches the last element of every range.
+	template <class... InputRanges>
+	class zip_range : public detail::zip_range_base<zip_range<InputRanges...>, ::std::tuple<InputRanges...>, typename ::std::common_type<typename range_traits<InputRanges>::range_category...>::type>
+	{
+		static_assert(sizeof...(InputRanges) > 0, "stdext::zip_range: at least one range is required");
+
+	public:
+		zip_range(InputRanges... ranges) : ranges(::std::move(ranges)...)
+		{
+			detail::trim_to_shortest(this->ranges, category());
+		}
+
+	private:
+		typedef typename ::std::common_type<typename range_traits<InputRanges>::range_category...>::type category;
+		friend struct detail::zip_range_base<zip_range, ::std::tuple<InputRanges...>, category, input_range_tag>;
+		friend struct detail::zip_range_base<zip_range, ::std::tuple<InputRanges...>, category, forward_range_tag>;
+		friend struct detail::zip_range_base<zip_range, ::std::tuple<InputRanges...>, category, bidirectional_range_tag>;
+		friend struct detail::zip_range_base<zip_range, ::std::tuple<InputRanges...>, category, random_access_range_tag>;
+
+		::std::tuple<InputRanges...> ranges;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// sliding_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		// A window is identified by the positions of its first and last elements.  The end position
+		// is the one whose last element would be the end of the underlying range.  All windows of a
+		// range advance in lockstep, so only the last positions are compared.
+		template <class Position>
+		struct window_position
+		{
+			Position first;
+			Position last;
+
+			friend bool operator == (const window_position& a, const window_position& b) { return a.last == b.last; }
+			friend bool operator != (const window_position& a, const window_position& b) { return !(a == b); }
+			friend bool operator < (const window_position& a, const window_position& b) { return a.last < b.last; }
+		};
+
+		template <class ForwardRange>
+		typename range_traits<ForwardRange>::position_type window_end_first(const ForwardRange& range, ::std::ptrdiff_t /* width */, ::std::false_type /* is_bidirectional_range */)
+		{
+			return range.end_pos();
+		}
+
+		template <class ForwardRange>
+		typename range_traits<ForwardRange>::position_type window_end_first(const ForwardRange& range, ::std::ptrdiff_t width, ::std::true_type /* is_bidirectional_range */)
+		{
+			auto p = range.end_pos();
+			return advance_pos(range, p, -(width - 1));
+		}
+
+		// Returns the positions of the first and the one-past-the-last windows of the given width.
+		template <class ForwardRange>
+		::std::pair<window_position<typename range_traits<ForwardRange>::position_type>, window_position<typename range_traits<ForwardRange>::position_type>>
+			window_bounds(const ForwardRange& range, ::std::ptrdiff_t width)
+		{
+			if (width <= 0)
+				throw ::std::domain_error("window width must be positive");
+
+			window_position<typename range_traits<ForwardRange>::position_type> first = { range.begin_pos(), range.begin_pos() };
+			auto p_last = range.end_pos();
+			for (auto n = width - 1; n > 0 && first.last != p_last; --n)
+				range.increment_pos(first.last);
+
+			if (first.last == p_last)
+				return { first, first };
+			return { first, { window_end_first(range, width, is_bidirectional_range<ForwardRange>()), p_last } };
+		}
+
+		template <class Range, class ForwardRange, class Category, class BaseCategory = Category>
+		struct sliding_range_base;
+
+		template <class Range, class ForwardRange, class Category>
+		struct sliding_range_base<Range, ForwardRange, Category, forward_range_tag>
+			: range<Category, ForwardRange, window_position<typename range_traits<ForwardRange>::position_type>, typename range_traits<ForwardRange>::difference_type, ForwardRange>
+		{
+			typedef typename range_traits<sliding_range_base>::position_type position_type;
+			typedef typename range_traits<sliding_range_base>::reference reference;
+			typedef typename range_traits<sliding_range_base>::difference_type difference_type;
+
+			position_type  begin_pos() const                     { return self().first; }
+			void           begin_pos(position_type p)            { self().first = ::std::move(p); }
+			position_type  end_pos() const                       { return self().last; }
+			void           end_pos(position_type p)              { self().last = ::std::move(p); }
+			reference      at_pos(const position_type& p) const
+			{
+				auto last = p.last;
+				return subrange(self().range, p.first, self().range.increment_pos(last));
+			}
+			position_type& increment_pos(position_type& p) const
+			{
+				self().range.increment_pos(p.first);
+				self().range.increment_pos(p.last);
+				return p;
+			}
+			difference_type distance_pos(position_type p1, position_type p2) const
+			{
+				return self().range.distance_pos(::std::move(p1.last), ::std::move(p2.last));
+			}
+
+		protected:
+			Range& self() { return static_cast<Range&>(*this); }
+			const Range& self() const { return static_cast<const Range&>(*this); }
+		};
+
+		template <class Range, class ForwardRange, class Category>
+		struct sliding_range_base<Range, ForwardRange, Category, bidirectional_range_tag>
+			: sliding_range_base<Range, ForwardRange, Category, forward_range_tag>
+		{
+			typedef typename range_traits<sliding_range_base>::position_type position_type;
+
+			position_type& decrement_pos(position_type& p) const
+			{
+				this->self().range.decrement_pos(p.first);
+				this->self().range.decrement_pos(p.last);
+				return p;
+			}
+		};
+
+		template <class Range, class ForwardRange, class Category>
+		struct sliding_range_base<Range, ForwardRange, Category, random_access_range_tag>
+			: sliding_range_base<Range, ForwardRange, Category, bidirectional_range_tag>
+		{
+			typedef typename range_traits<sliding_range_base>::position_type position_type;
+			typedef typename range_traits<sliding_range_base>::difference_type difference_type;
+
+			position_type& advance_pos(position_type& p, difference_type n) const
+			{
+				this->self().range.advance_pos(p.first, n);
+				this->self().range.advance_pos(p.last, n);
+				return p;
+			}
+		};
+	}
+
+	// Yields every window of a given width over the underlying range as a subrange: the elements
+	// [0, width), then [1, width + 1), and so on.  If the underlying range is shorter than the
+	// window, there are no windows.  Throws domain_error if width is not positive.
+	template <class ForwardRange>
+	class sliding_range : public detail::sliding_range_base<sliding_range<ForwardRange>, ForwardRange, typename range_traits<ForwardRange>::range_category>
+	{
+		static_assert(is_forward_range<ForwardRange>::value, "stdext::sliding_range: underlying range is not a forward range");
+
+	public:
+		typedef typename range_traits<sliding_range>::position_type position_type;
+
+	public:
+		sliding_range(ForwardRange range, ::std::ptrdiff_t width) : range(::std::move(range))
+		{
+			auto bounds = detail::window_bounds(this->range, width);
+			first = bounds.first;
+			last = bounds.second;
+		}
+
+	private:
+		typedef typename range_traits<ForwardRange>::range_category category;
+		friend struct detail::sliding_range_base<sliding_range, ForwardRange, category, forward_range_tag>;
+		friend struct detail::sliding_range_base<sliding_range, ForwardRange, category, bidirectional_range_tag>;
+		friend struct detail::sliding_range_base<sliding_range, ForwardRange, category, random_access_range_tag>;
+
+		ForwardRange range;
+		position_type first, last;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// aggregated_range
+	////////////////////////////////////////////////////////////////
+
+	// Rolling aggregators maintain an aggregate over a window of values.  push(v) adds v as the
+	// newest value, pop(v) removes v, which must be the oldest value in the window, and value()
+	// returns the aggregate of the current window.  Each operation is O(1) amortized.
+	template <class T>
+	class rolling_sum
+	{
+	public:
+		rolling_sum() : sum() { }
+
+		void push(const T& v) { sum += v; }
+		void pop(const T& v)  { sum -= v; }
+		T value() const       { return sum; }
+
+	private:
+		T sum;
+	};
+
+	template <class T>
+	class rolling_mean
+	{
+	public:
+		rolling_mean() : sum(), count(0) { }
+
+		void push(const T& v)  { sum += v; ++count; }
+		void pop(const T& v)   { sum -= v; --count; }
+		double value() const   { return static_cast<double>(sum) / count; }
+
+	private:
+		T sum;
+		::std::ptrdiff_t count;
+	};
+
+	// rolling_min and rolling_max keep a monotonic deque of the values that could still become
+	// the extreme of some later window: a new value evicts every value behind it that it beats.
+	template <class T, class Compare = ::std::less<T>>
+	class rolling_min
+	{
+	public:
+		rolling_min(Compare comp = Compare()) : comp(::std::move(comp)) { }
+
+		void push(const T& v)
+		{
+			while (!candidates.empty() && comp(v, candidates.back()))
+				candidates.pop_back();
+			candidates.push_back(v);
+		}
+		void pop(const T& v)
+		{
+			if (!comp(candidates.front(), v))
+				candidates.pop_front();
+		}
+		const T& value() const { return candidates.front(); }
+
+	private:
+		::std::deque<T> candidates;
+		Compare comp;
+	};
+
+	template <class T>
+	class rolling_max : public rolling_min<T, ::std::greater<T>>
+	{
+	};
+
+	// Yields an aggregate of every window of a given width over the underlying range.  The
+	// aggregate is maintained incrementally: advancing to the next window pushes one value into
+	// the aggregator and pops one value from it, rather than rescanning the window.  The aggregator
+	// is shared by copies of the range and advances with the positions, so this is an input range.
+	// Throws domain_error if width is not positive.
+	template <class ForwardRange, class Aggregator>
+	class aggregated_range
+		: public range<input_range_tag,
+			typename ::std::decay<decltype(::std::declval<const Aggregator&>().value())>::type,
+			detail::window_position<typename range_traits<ForwardRange>::position_type>,
+			typename range_traits<ForwardRange>::difference_type,
+			typename ::std::decay<decltype(::std::declval<const Aggregator&>().value())>::type>
+	{
+		static_assert(is_forward_range<ForwardRange>::value, "stdext::aggregated_range: underlying range is not a forward range");
+
+	public:
+		typedef typename range_traits<aggregated_range>::position_type position_type;
+		typedef typename range_traits<aggregated_range>::reference reference;
+
+	public:
+		aggregated_range(ForwardRange range, ::std::ptrdiff_t width, Aggregator agg)
+			: range(::std::move(range)), agg(::std::make_shared<Aggregator>(::std::move(agg)))
+		{
+			auto bounds = detail::window_bounds(this->range, width);
+			first = bounds.first;
+			last = bounds.second;
+			if (first != last)
+			{
+				auto p = first.first;
+				this->agg->push(this->range.at_pos(p));
+				while (p != first.last)
+					this->agg->push(this->range.at_pos(this->range.increment_pos(p)));
+			}
+		}
+
+	public:
+		position_type  begin_pos() const                     { return first; }
+		void           begin_pos(position_type p)            { first = ::std::move(p); }
+		position_type  end_pos() const                       { return last; }
+		reference      at_pos(const position_type&) const    { return agg->value(); }
+		position_type& increment_pos(position_type& p) const
+		{
+			agg->pop(range.at_pos(p.first));
+			range.increment_pos(p.first);
+			range.increment_pos(p.last);
+			if (p.last != range.end_pos())
+				agg->push(range.at_pos(p.last));
+			return p;
+		}
+
+	private:
+		ForwardRange range;
+		::std::shared_ptr<Aggregator> agg;
+		position_type first, last;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// merged_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		// The state of a k-way merge: the current position in each input, and a loser tree over
+		// the inputs.  tree[0] holds the index of the input with the smallest current element;
+		// each internal node n in [1, k) holds the loser of the match played at that node, whose
+		// children are nodes 2n and 2n + 1.  Node k + i is the leaf for input i.
+		template <class Position>
+		struct merge_position
+		{
+			::std::vector<Position> cursors;
+			::std::vector<::std::size_t> tree;
+			::std::size_t consumed;
+			bool done;
+
+			friend bool operator == (const merge_position& a, const merge_position& b)
+			{
+				return a.done == b.done && (a.done || a.consumed == b.consumed);
+			}
+			friend bool operator != (const merge_position& a, const merge_position& b) { return !(a == b); }
+		};
+	}
+
+	// Yields the sorted union of any number of sorted ranges of the same type.  Each element costs
+	// O(log k) comparisons, replaying a single path of the loser tree; the merge state is allocated
+	// once, when the begin position is created.  Elements that compare equal are yielded in the
+	// order of the ranges they came from.
+	template <class InputRange, class Compare>
+	class merged_range : public range<input_range_tag,
+		typename range_traits<InputRange>::value_type,
+		detail::merge_position<typename range_traits<InputRange>::position_type>,
+		typename range_traits<InputRange>::difference_type,
+		typename range_traits<InputRange>::reference>
+	{
+	public:
+		typedef typename range_traits<merged_range>::position_type position_type;
+		typedef typename range_traits<merged_range>::reference reference;
+
+	public:
+		merged_range(::std::vector<InputRange> ranges, Compare comp) : ranges(::std::move(ranges)), comp(::std::move(comp)), first(start()) { }
+
+	public:
+		position_type  begin_pos() const                     { return first; }
+		void           begin_pos(position_type p)            { first = ::std::move(p); }
+		position_type  end_pos() const                       { return { { }, { }, 0, true }; }
+		reference      at_pos(const position_type& p) const
+		{
+			auto i = p.tree[0];
+			return ranges[i].at_pos(p.cursors[i]);
+		}
+		position_type& increment_pos(position_type& p) const
+		{
+			auto winner = p.tree[0];
+			ranges[winner].increment_pos(p.cursors[winner]);
+			auto k = ranges.size();
+			for (auto n = (winner + k) / 2; n > 0; n /= 2)
+			{
+				if (beats(p, p.tree[n], winner))
+					::std::swap(p.tree[n], winner);
+			}
+			p.tree[0] = winner;
+			++p.consumed;
+			p.done = exhausted(p, winner);
+			return p;
+		}
+
+	private:
+		position_type start() const
+		{
+			auto k = ranges.size();
+			position_type p = { { }, ::std::vector<::std::size_t>(k == 0 ? 1 : k), 0, false };
+			p.cursors.reserve(k);
+			for (auto& r : ranges)
+				p.cursors.push_back(r.begin_pos());
+
+			// Play the initial tournament bottom-up, recording the winner of each internal node in
+			// a scratch array.
+			::std::vector<::std::size_t> winners(k);
+			for (auto n = k; n-- > 1; )
+			{
+				auto a = 2 * n < k ? winners[2 * n] : 2 * n - k;
+				auto b = 2 * n + 1 < k ? winners[2 * n + 1] : 2 * n + 1 - k;
+				if (beats(p, b, a))
+					::std::swap(a, b);
+				winners[n] = a;
+				p.tree[n] = b;
+			}
+			p.tree[0] = k > 1 ? winners[1] : 0;
+			p.done = k == 0 || exhausted(p, p.tree[0]);
+			return p;
+		}
+
+		bool exhausted(const position_type& p, ::std::size_t i) const
+		{
+			return p.cursors[i] == ranges[i].end_pos();
+		}
+
+		// Whether input i's current element should be yielded before input j's.  Exhausted inputs
+		// lose every match, and ties go to the earlier input.
+		bool beats(const position_type& p, ::std::size_t i, ::std::size_t j) const
+		{
+			if (exhausted(p, j))
+				return true;
+			if (exhausted(p, i))
+				return false;
+			auto&& a = ranges[i].at_pos(p.cursors[i]);
+			auto&& b = ranges[j].at_pos(p.cursors[j]);
+			return i < j ? !comp(b, a) : comp(a, b);
+		}
+
+	private:
+		::std::vector<InputRange> ranges;
+		Compare comp;
+		position_type first;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// set_operation_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		// Each set operation is described by which elements it keeps when merging two sorted
+		// ranges: those found only in the first range, those found only in the second, and those
+		// found in both (which are taken from the first range).
+		struct set_union_op                { static const bool first = true,  second = true,  both = true;  };
+		struct set_intersection_op         { static const bool first = false, second = false, both = true;  };
+		struct set_difference_op           { static const bool first = true,  second = false, both = false; };
+		struct set_symmetric_difference_op { static const bool first = true,  second = true,  both = false; };
+
+		enum class set_side { first, second, both };
+
+		template <class Position1, class Position2>
+		struct set_operation_position
+		{
+			Position1 p1;
+			Position2 p2;
+			set_side side;
+
+			friend bool operator == (const set_operation_position& a, const set_operation_position& b) { return a.p1 == b.p1 && a.p2 == b.p2; }
+			friend bool operator != (const set_operation_position& a, const set_operation_position& b) { return !(a == b); }
+		};
+
+		// Elements yielded from the second range must be convertible to the first range's
+		// reference type; when the two differ, elements are yielded by value.
+		template <class Range1, class Range2, class Operation>
+		struct set_operation_reference
+		{
+			typedef typename ::std::conditional<
+				!Operation::second || ::std::is_same<typename range_traits<Range1>::reference, typename range_traits<Range2>::reference>::value,
+				typename range_traits<Range1>::reference,
+				typename ::std::common_type<typename range_traits<Range1>::value_type, typename range_traits<Range2>::value_type>::type>::type type;
+		};
+	}
+
+	// Lazily computes a set operation over two ranges sorted by the same ordering, with the same
+	// multiset semantics as the corresponding std:: algorithms.  Nothing is materialized; each
+	// increment advances through the inputs only until the next element of the result.
+	template <class ForwardRange1, class ForwardRange2, class Operation, class Compare>
+	class set_operation_range : public range<forward_range_tag,
+		typename ::std::decay<typename detail::set_operation_reference<ForwardRange1, ForwardRange2, Operation>::type>::type,
+		detail::set_operation_position<typename range_traits<ForwardRange1>::position_type, typename range_traits<ForwardRange2>::position_type>,
+		typename range_traits<ForwardRange1>::difference_type,
+		typename detail::set_operation_reference<ForwardRange1, ForwardRange2, Operation>::type>
+	{
+		static_assert(is_forward_range<ForwardRange1>::value, "stdext::set_operation_range: first range is not a forward range");
+		static_assert(is_forward_range<ForwardRange2>::value, "stdext::set_operation_range: second range is not a forward range");
+
+	public:
+		typedef typename range_traits<set_operation_range>::position_type position_type;
+		typedef typename range_traits<set_operation_range>::reference reference;
+		typedef typename range_traits<set_operation_range>::difference_type difference_type;
+
+	public:
+		set_operation_range(ForwardRange1 range1, ForwardRange2 range2, Compare comp)
+			: range1(::std::move(range1)), range2(::std::move(range2)), comp(::std::move(comp))
+		{
+			first = { this->range1.begin_pos(), this->range2.begin_pos(), detail::set_side::first };
+			settle(first);
+		}
+
+	public:
+		position_type  begin_pos() const                     { return first; }
+		void           begin_pos(position_type p)            { first = ::std::move(p); }
+		position_type  end_pos() const                       { return { range1.end_pos(), range2.end_pos(), detail::set_side::first }; }
+		void           end_pos(position_type p)
+		{
+			range1.end_pos(::std::move(p.p1));
+			range2.end_pos(::std::move(p.p2));
+		}
+		reference      at_pos(const position_type& p) const
+		{
+			return p.side == detail::set_side::second ? range2.at_pos(p.p2) : range1.at_pos(p.p1);
+		}
+		position_type& increment_pos(position_type& p) const
+		{
+			if (p.side != detail::set_side::second)
+				range1.increment_pos(p.p1);
+			if (p.side != detail::set_side::first)
+				range2.increment_pos(p.p2);
+			settle(p);
+			return p;
+		}
+		difference_type distance_pos(position_type p1, const position_type& p2) const
+		{
+			difference_type n = 0;
+			for (; p1 != p2; increment_pos(p1))
+				++n;
+			return n;
+		}
+
+	private:
+		// Advances p past the elements the operation discards, leaving it at the next element to
+		// yield.  Once the result is exhausted, p is moved to the end of both ranges so that it
+		// compares equal to end_pos().
+		void settle(position_type& p) const
+		{
+			auto last1 = range1.end_pos();
+			auto last2 = range2.end_pos();
+			for (;;)
+			{
+				bool at_end1 = p.p1 == last1, at_end2 = p.p2 == last2;
+				if (at_end1 && at_end2)
+				{
+					p.side = detail::set_side::first;
+					return;
+				}
+				else if (at_end2)
+				{
+					if (Operation::first)
+					{
+						p.side = detail::set_side::first;
+						return;
+					}
+					p.p1 = last1;
+				}
+				else if (at_end1)
+				{
+					if (Operation::second)
+					{
+						p.side = detail::set_side::second;
+						return;
+					}
+					p.p2 = last2;
+				}
+				else if (comp(range1.at_pos(p.p1), range2.at_pos(p.p2)))
+				{
+					if (Operation::first)
+					{
+						p.side = detail::set_side::first;
+						return;
+					}
+					range1.increment_pos(p.p1);
+				}
+				else if (comp(range2.at_pos(p.p2), range1.at_pos(p.p1)))
+				{
+					if (Operation::second)
+					{
+						p.side = detail::set_side::second;
+						return;
+					}
+					range2.increment_pos(p.p2);
+				}
+				else
+				{
+					if (Operation::both)
+					{
+						p.side = detail::set_side::both;
+						return;
+					}
+					range1.increment_pos(p.p1);
+					range2.increment_pos(p.p2);
+				}
+			}
+		}
+
+	private:
+		ForwardRange1 range1;
+		ForwardRange2 range2;
+		Compare comp;
+		position_type first;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// top_k_range
+	////////////////////////////////////////////////////////////////
+
+	// The k elements of a range that come first under a comparison, in sorted order, so that
+	// r >> top_k(k, ::std::greater<>()) yields the k largest.  The source is read once, as an input
+	// range, and the range holds copies of the elements selected.
+	template <class T>
+	class top_k_range : public range<random_access_range_tag, T, ::std::size_t, ::std::ptrdiff_t, const T&>
+	{
+	public:
+		typedef typename range_traits<top_k_range>::position_type position_type;
+		typedef typename range_traits<top_k_range>::reference reference;
+		typedef typename range_traits<top_k_range>::difference_type difference_type;
+
+	public:
+		top_k_range() : first(0), last(0) { }
+		explicit top_k_range(::std::vector<T> values) : values(::std::move(values)), first(0), last(this->values.size()) { }
+
+	public:
+		position_type  begin_pos() const noexcept                             { return first; }
+		void           begin_pos(position_type p) noexcept                    { first = p; }
+		position_type  end_pos() const noexcept                               { return last; }
+		void           end_pos(position_type p) noexcept                      { last = p; }
+		reference      at_pos(position_type p) const noexcept                 { return values[p]; }
+		position_type& increment_pos(position_type& p) const noexcept         { return ++p; }
+		position_type& decrement_pos(position_type& p) const noexcept         { return --p; }
+		position_type& advance_pos(position_type& p, difference_type n) const noexcept { return p += n; }
+		difference_type distance_pos(position_type p1, position_type p2) const noexcept  { return difference_type(p2 - p1); }
+
+	private:
+		::std::vector<T> values;
+		position_type first, last;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// grouped_range
+	////////////////////////////////////////////////////////////////
+
+	// Group aggregators compute one aggregate per group for group_aggregate.  start(e) returns the
+	// state of a group whose first element is e, push(state, e) adds a further element e and
+	// value(state) returns the aggregate.  One aggregator serves every group; only the states,
+	// which are kept in the hash table beside the key, are per group.
+	class count_aggregator
+	{
+	public:
+		template <class Element> ::std::size_t start(const Element&) const      { return 1; }
+		template <class Element> void push(::std::size_t& n, const Element&) const { ++n; }
+		::std::size_t value(::std::size_t n) const                              { return n; }
+	};
+
+	// Sums op(e) over the elements of each group.
+	template <class Operation>
+	class sum_aggregator
+	{
+	public:
+		explicit sum_aggregator(Operation op) : op(::std::move(op)) { }
+
+		template <class Element>
+		typename ::std::decay<decltype(::std::declval<const Operation&>()(::std::declval<const Element&>()))>::type
+			start(const Element& e) const                         { return op(e); }
+		template <class T, class Element>
+		void push(T& sum, const Element& e) const                 { sum += op(e); }
+		template <class T>
+		T value(const T& sum) const                               { return sum; }
+
+	private:
+		Operation op;
+	};
+
+	// The least op(e) over the elements of each group under comp, or the greatest under ::std::greater<>.
+	template <class Operation, class Compare>
+	class min_aggregator
+	{
+	public:
+		min_aggregator(Operation op, Compare comp) : op(::std::move(op)), comp(::std::move(comp)) { }
+
+		template <class Element>
+		typename ::std::decay<decltype(::std::declval<const Operation&>()(::std::declval<const Element&>()))>::type
+			start(const Element& e) const                         { return op(e); }
+		template <class T, class Element>
+		void push(T& least, const Element& e) const
+		{
+			auto&& v = op(e);
+			if (comp(v, least))
+				least = ::std::forward<decltype(v)>(v);
+		}
+		template <class T>
+		T value(const T& least) const                             { return least; }
+
+	private:
+		Operation op;
+		Compare comp;
+	};
+
+	// Folds the elements of each group into init with state = op(state, e).
+	template <class T, class Operation>
+	class fold_aggregator
+	{
+	public:
+		fold_aggregator(T init, Operation op) : init(::std::move(init)), op(::std::move(op)) { }
+
+		template <class Element>
+		T start(const Element& e) const                           { return op(init, e); }
+		template <class Element>
+		void push(T& state, const Element& e) const               { state = op(::std::move(state), e); }
+		T value(const T& state) const                             { return state; }
+
+	private:
+		T init;
+		Operation op;
+	};
+
+	// The rows produced by group_aggregate, one ::std::tuple per group holding its key followed
+	// by its aggregates, in no particular order.
+	template <class Row>
+	class grouped_range : public range<random_access_range_tag, Row, ::std::size_t, ::std::ptrdiff_t, const Row&>
+	{
+	public:
+		typedef typename range_traits<grouped_range>::position_type position_type;
+		typedef typename range_traits<grouped_range>::reference reference;
+		typedef typename range_traits<grouped_range>::difference_type difference_type;
+
+	public:
+		grouped_range() : first(0), last(0) { }
+		explicit grouped_range(::std::vector<Row> rows) : rows(::std::move(rows)), first(0), last(this->rows.size()) { }
+
+	public:
+		position_type  begin_pos() const noexcept                             { return first; }
+		void           begin_pos(position_type p) noexcept                    { first = p; }
+		position_type  end_pos() const noexcept                               { return last; }
+		void           end_pos(position_type p) noexcept                      { last = p; }
+		reference      at_pos(position_type p) const noexcept                 { return rows[p]; }
+		position_type& increment_pos(position_type& p) const noexcept         { return ++p; }
+		position_type& decrement_pos(position_type& p) const noexcept         { return --p; }
+		position_type& advance_pos(position_type& p, difference_type n) const noexcept { return p += n; }
+		difference_type distance_pos(position_type p1, position_type p2) const noexcept  { return difference_type(p2 - p1); }
+
+	private:
+		::std::vector<Row> rows;
+		position_type first, last;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// chunk_by_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		// A chunk is identified by the positions of its first element and of the element after its
+		// last.  Chunks do not overlap, so only the first positions are compared.
+		template <class Position>
+		struct chunk_position
+		{
+			Position first;
+			Position last;
+
+			friend bool operator == (const chunk_position& a, const chunk_position& b) { return a.first == b.first; }
+			friend bool operator != (const chunk_position& a, const chunk_position& b) { return !(a == b); }
+		};
+
+		template <class Range, class ForwardRange, class Predicate, class Category, class BaseCategory = Category>
+		struct chunk_by_range_base;
+
+		template <class Range, class ForwardRange, class Predicate, class Category>
+		struct chunk_by_range_base<Range, ForwardRange, Predicate, Category, forward_range_tag>
+			: range<Category, ForwardRange, chunk_position<typename range_traits<ForwardRange>::position_type>, typename range_traits<ForwardRange>::difference_type, ForwardRange>
+		{
+			typedef typename range_traits<chunk_by_range_base>::position_type position_type;
+			typedef typename range_traits<chunk_by_range_base>::reference reference;
+			typedef typename range_traits<chunk_by_range_base>::difference_type difference_type;
+
+			position_type  begin_pos() const                     { return self().first; }
+			void           begin_pos(position_type p)            { self().first = ::std::move(p); }
+			position_type  end_pos() const                       { return self().last; }
+			void           end_pos(position_type p)              { self().last = ::std::move(p); }
+			reference      at_pos(const position_type& p) const  { return subrange(self().range, p.first, p.last); }
+			position_type& increment_pos(position_type& p) const
+			{
+				p.first = p.last;
+				p.last = chunk_last(p.first);
+				return p;
+			}
+			difference_type distance_pos(position_type p1, const position_type& p2) const
+			{
+				difference_type distance = 0;
+				for (; p1 != p2; increment_pos(p1))
+					++distance;
+				return distance;
+			}
+
+		protected:
+			Range& self() { return static_cast<Range&>(*this); }
+			const Range& self() const { return static_cast<const Range&>(*this); }
+
+			// The position after the last element of the chunk that begins at p.
+			typename range_traits<ForwardRange>::position_type chunk_last(typename range_traits<ForwardRange>::position_type p) const
+			{
+				auto& r = self().range;
+				auto p_last = r.end_pos();
+				if (p == p_last)
+					return p;
+				for (auto next = p; r.increment_pos(next) != p_last; p = next)
+				{
+					if (!self().pred(r.at_pos(p), r.at_pos(next)))
+						return next;
+				}
+				return p_last;
+			}
+		};
+
+		template <class Range, class ForwardRange, class Predicate, class Category>
+		struct chunk_by_range_base<Range, ForwardRange, Predicate, Category, bidirectional_range_tag>
+			: chunk_by_range_base<Range, ForwardRange, Predicate, Category, forward_range_tag>
+		{
+			typedef typename range_traits<chunk_by_range_base>::position_type position_type;
+
+			position_type& decrement_pos(position_type& p) const
+			{
+				auto& r = this->self().range;
+				p.last = p.first;
+				r.decrement_pos(p.first);
+				for (auto prev = p.first; p.first != r.begin_pos(); p.first = prev)
+				{
+					if (!this->self().pred(r.at_pos(r.decrement_pos(prev)), r.at_pos(p.first)))
+						break;
+				}
+				return p;
+			}
+		};
+	}
+
+	// Splits the underlying range into maximal runs of adjacent elements for which pred(previous,
+	// next) holds, and yields each run as a subrange.  Over a range sorted by some key,
+	// r >> group_by_key(key) yields the group of every key in a single streaming pass, without
+	// the hash table of group_aggregate: the range keeps only the bounds of the current chunk.
+	template <class ForwardRange, class Predicate>
+	class chunk_by_range : public detail::chunk_by_range_base<chunk_by_range<ForwardRange, Predicate>, ForwardRange, Predicate,
+		typename ::std::common_type<typename range_traits<ForwardRange>::range_category, bidirectional_range_tag>::type>
+	{
+		static_assert(is_forward_range<ForwardRange>::value, "stdext::chunk_by_range: underlying range is not a forward range");
+
+	public:
+		typedef typename range_traits<chunk_by_range>::position_type position_type;
+
+	public:
+		chunk_by_range(ForwardRange range, Predicate pred) : range(::std::move(range)), pred(::std::move(pred))
+		{
+			auto p_first = this->range.begin_pos(), p_last = this->range.end_pos();
+			first = { p_first, this->chunk_last(p_first) };
+			last = { p_last, p_last };
+		}
+
+	private:
+		typedef typename ::std::common_type<typename range_traits<ForwardRange>::range_category, bidirectional_range_tag>::type category;
+		friend struct detail::chunk_by_range_base<chunk_by_range, ForwardRange, Predicate, category, forward_range_tag>;
+		friend struct detail::chunk_by_range_base<chunk_by_range, ForwardRange, Predicate, category, bidirectional_range_tag>;
+
+		ForwardRange range;
+		Predicate pred;
+		position_type first, last;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// reduced_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		template <class Range, class Aggregator>
+		using group_reduction_t = aggregate_value_t<Aggregator, typename range_traits<typename range_traits<Range>::value_type>::reference>;
+	}
+
+	// Yields one aggregate for every group of a range of groups, such as a chunk_by_range, using
+	// the group aggregators of group_aggregate: r >> group_by_key(key) >> reduce_groups(group_sum(f))
+	// sums f over each run of equal keys.  Groups must not be empty.  Each group is reduced when
+	// it is read, so reading an element twice reduces its group twice.
+	template <class ForwardRange, class Aggregator>
+	class reduced_range : public range<forward_range_tag,
+		detail::group_reduction_t<ForwardRange, Aggregator>,
+		typename range_traits<ForwardRange>::position_type,
+		typename range_traits<ForwardRange>::difference_type,
+		detail::group_reduction_t<ForwardRange, Aggregator>>
+	{
+		static_assert(is_forward_range<ForwardRange>::value, "stdext::reduced_range: underlying range is not a forward range");
+
+	public:
+		typedef typename range_traits<reduced_range>::position_type position_type;
+		typedef typename range_traits<reduced_range>::reference reference;
+		typedef typename range_traits<reduced_range>::difference_type difference_type;
+
+	public:
+		reduced_range(ForwardRange range, Aggregator agg) : range(::std::move(range)), agg(::std::move(agg))
+		{
+		}
+
+	public:
+		position_type  begin_pos() const                     { return range.begin_pos(); }
+		void           begin_pos(position_type p)            { range.begin_pos(::std::move(p)); }
+		position_type  end_pos() const                       { return range.end_pos(); }
+		void           end_pos(position_type p)              { range.end_pos(::std::move(p)); }
+		reference      at_pos(const position_type& p) const
+		{
+			auto&& group = range.at_pos(p);
+			auto q = group.begin_pos(), q_last = group.end_pos();
+			auto state = agg.start(group.at_pos(q));
+			while (group.increment_pos(q) != q_last)
+				agg.push(state, group.at_pos(q));
+			return agg.value(state);
+		}
+		position_type& increment_pos(position_type& p) const { return range.increment_pos(p); }
+		difference_type distance_pos(position_type p1, position_type p2) const { return range.distance_pos(::std::move(p1), ::std::move(p2)); }
+
+	private:
+		ForwardRange range;
+		Aggregator agg;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// hash_join_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		template <class BuildRange, class BuildKey> class join_table;
+
+		// The row index that ends a chain of matching rows in a join_table.
+		const ::std::size_t join_end = ::std::size_t(-1);
+
+		// A join position is the position of a probe element, the position of the build element
+		// it is currently matched with, and the index of its next match in the table, if any.
+		template <class ProbePosition, class BuildPosition>
+		struct hash_join_position
+		{
+			ProbePosition probe;
+			BuildPosition build;
+			::std::size_t more;
+
+			friend bool operator == (const hash_join_position& a, const hash_join_position& b) { return a.probe == b.probe && a.build == b.build; }
+			friend bool operator != (const hash_join_position& a, const hash_join_position& b) { return !(a == b); }
+		};
+
+		template <class Range, class BuildRange, class ProbeRange, class Category, class BaseCategory = Category>
+		struct hash_join_range_base;
+
+		template <class Range, class BuildRange, class ProbeRange, class Category>
+		struct hash_join_range_base<Range, BuildRange, ProbeRange, Category, input_range_tag>
+			: range<Category,
+				::std::tuple<typename range_traits<BuildRange>::value_type, typename range_traits<ProbeRange>::value_type>,
+				hash_join_position<typename range_traits<ProbeRange>::position_type, typename range_traits<BuildRange>::position_type>,
+				typename range_traits<ProbeRange>::difference_type,
+				zip_reference<typename range_traits<BuildRange>::reference, typename range_traits<ProbeRange>::reference>>
+		{
+			typedef typename range_traits<hash_join_range_base>::position_type position_type;
+			typedef typename range_traits<hash_join_range_base>::reference reference;
+
+			position_type  begin_pos() const                     { return self().first; }
+			void           begin_pos(position_type p)            { self().first = ::std::move(p); }
+			position_type  end_pos() const                       { return self().last; }
+			reference      at_pos(const position_type& p) const  { return reference(self().table->build().at_pos(p.build), self().probe.at_pos(p.probe)); }
+			position_type& increment_pos(position_type& p) const
+			{
+				if (p.more == join_end)
+					return self().match(self().probe.increment_pos(p.probe), p);
+				p.build = self().table->row(p.more);
+				p.more = self().table->next_row(p.more);
+				return p;
+			}
+
+		protected:
+			Range& self() { return static_cast<Range&>(*this); }
+			const Range& self() const { return static_cast<const Range&>(*this); }
+		};
+
+		template <class Range, class BuildRange, class ProbeRange, class Category>
+		struct hash_join_range_base<Range, BuildRange, ProbeRange, Category, forward_range_tag>
+			: hash_join_range_base<Range, BuildRange, ProbeRange, Category, input_range_tag>
+		{
+			typedef typename range_traits<hash_join_range_base>::position_type position_type;
+			typedef typename range_traits<hash_join_range_base>::difference_type difference_type;
+
+			using hash_join_range_base<Range, BuildRange, ProbeRange, Category, input_range_tag>::end_pos;
+			void end_pos(position_type p) { this->self().last = ::std::move(p); }
+			difference_type distance_pos(position_type p1, const position_type& p2) const
+			{
+				difference_type distance = 0;
+				for (; p1 != p2; this->increment_pos(p1))
+					++distance;
+				return distance;
+			}
+		};
+	}
+
+	// The equijoin of two ranges: every pair of a build element b and a probe element e with
+	// build_key(b) == probe_key(e), as a zip_reference to both, in the order of the probe range
+	// and then of the build range.  The build range is read once on construction into a hash
+	// table of its positions, so it must be a forward range and should be the smaller input; the
+	// probe range is then streamed as it is read and may be an input range.  Probe keys are hashed
+	// as build keys.  Copies of the range share the table.
+	template <class BuildRange, class ProbeRange, class BuildKey, class ProbeKey>
+	class hash_join_range : public detail::hash_join_range_base<hash_join_range<BuildRange, ProbeRange, BuildKey, ProbeKey>, BuildRange, ProbeRange,
+		typename ::std::common_type<typename range_traits<ProbeRange>::range_category, forward_range_tag>::type>
+	{
+		static_assert(is_forward_range<BuildRange>::value, "stdext::hash_join_range: build range is not a forward range");
+
+	public:
+		typedef typename range_traits<hash_join_range>::position_type position_type;
+
+	public:
+		hash_join_range(BuildRange build, ProbeRange probe, BuildKey build_key, ProbeKey probe_key)
+			: table(::std::make_shared<const detail::join_table<BuildRange, BuildKey>>(::std::move(build), ::std::move(build_key))),
+			  probe(::std::move(probe)), probe_key(::std::move(probe_key))
+		{
+			last = { this->probe.end_pos(), table->build().end_pos(), detail::join_end };
+			match(this->probe.begin_pos(), first);
+		}
+
+	private:
+		typedef typename ::std::common_type<typename range_traits<ProbeRange>::range_category, forward_range_tag>::type category;
+		friend struct detail::hash_join_range_base<hash_join_range, BuildRange, ProbeRange, category, input_range_tag>;
+		friend struct detail::hash_join_range_base<hash_join_range, BuildRange, ProbeRange, category, forward_range_tag>;
+
+		// Sets p to the first match of the first probe element at or after q, or to the end.
+		position_type& match(const typename range_traits<ProbeRange>::position_type& q, position_type& p) const
+		{
+			p.probe = q;
+			for (auto p_last = probe.end_pos(); p.probe != p_last; probe.increment_pos(p.probe))
+			{
+				if (auto e = table->find(probe_key(probe.at_pos(p.probe))))
+				{
+					p.build = e->first;
+					p.more = e->more;
+					return p;
+				}
+			}
+			return p = last;
+		}
+
+		::std::shared_ptr<const detail::join_table<BuildRange, BuildKey>> table;
+		ProbeRange probe;
+		ProbeKey probe_key;
+		position_type first, last;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// merge_join_range
+	////////////////////////////////////////////////////////////////
+	namespace detail
+	{
+		// A merge join position is the position of an element of range1 and of its current match
+		// in range2, and the bounds of the run of elements of range2 with the same key.
+		template <class Position1, class Position2>
+		struct merge_join_position
+		{
+			Position1 first;
+			Position2 second;
+			Position2 run_first;
+			Position2 run_last;
+
+			friend bool operator == (const merge_join_position& a, const merge_join_position& b) { return a.first == b.first && a.second == b.second; }
+			friend bool operator != (const merge_join_position& a, const merge_join_position& b) { return !(a == b); }
+		};
+
+		template <class ForwardRange, class T, class Compare>
+		typename range_traits<ForwardRange>::position_type
+			join_lower_bound(const ForwardRange& range, typename range_traits<ForwardRange>::position_type p, const T& value, Compare comp, bool, ::std::false_type /* is_random_access_range */)
+		{
+			for (auto p_last = range.end_pos(); p != p_last && comp(range.at_pos(p), value); )
+				range.increment_pos(p);
+			return p;
+		}
+
+		template <class RandomAccessRange, class T, class Compare>
+		typename range_traits<RandomAccessRange>::position_type
+			join_lower_bound(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type p, const T& value, Compare comp, bool gallop, ::std::true_type /* is_random_access_range */)
+		{
+			if (gallop)
+				return gallop_lower_bound(range, ::std::move(p), value, comp);
+			return join_lower_bound(range, ::std::move(p), value, comp, false, ::std::false_type());
+		}
+	}
+
+	// The equijoin of two ranges sorted by key under comp: every pair of an element a of range1
+	// and an element b of range2 with equal key1(a) and key2(b), as a zip_reference to both, in
+	// key order.  Each run of equal keys in range2 is read once for every element of range1 with
+	// that key.  When both ranges are random access and one is much longer than the other, the
+	// longer one is skipped through by galloping, so a join of a few keys against many costs
+	// O(log gap) comparisons per key.
+	template <class ForwardRange1, class ForwardRange2, class Key1, class Key2, class Compare>
+	class merge_join_range : public range<forward_range_tag,
+		::std::tuple<typename range_traits<ForwardRange1>::value_type, typename range_traits<ForwardRange2>::value_type>,
+		detail::merge_join_position<typename range_traits<ForwardRange1>::position_type, typename range_traits<ForwardRange2>::position_type>,
+		::std::ptrdiff_t,
+		zip_reference<typename range_traits<ForwardRange1>::reference, typename range_traits<ForwardRange2>::reference>>
+	{
+		static_assert(is_forward_range<ForwardRange1>::value, "stdext::merge_join_range: range1 is not a forward range");
+		static_assert(is_forward_range<ForwardRange2>::value, "stdext::merge_join_range: range2 is not a forward range");
+
+	public:
+		typedef typename range_traits<merge_join_range>::position_type position_type;
+		typedef typename range_traits<merge_join_range>::reference reference;
+		typedef typename range_traits<merge_join_range>::difference_type difference_type;
+
+	public:
+		merge_join_range(ForwardRange1 range1, ForwardRange2 range2, Key1 key1, Key2 key2, Compare comp)
+			: range1(::std::move(range1)), range2(::std::move(range2)), key1(::std::move(key1)), key2(::std::move(key2)), comp(::std::move(comp)),
+			  gallop1(false), gallop2(false)
+		{
+			skewed(detail::is_random_access_pair<ForwardRange1, ForwardRange2>());
+			auto p_first2 = this->range2.begin_pos(), p_last2 = this->range2.end_pos();
+			first = { this->range1.begin_pos(), p_first2, p_first2, p_first2 };
+			last = { this->range1.end_pos(), p_last2, p_last2, p_last2 };
+			match(first);
+		}
+
+	public:
+		position_type  begin_pos() const                     { return first; }
+		void           begin_pos(position_type p)            { first = ::std::move(p); }
+		position_type  end_pos() const                       { return last; }
+		void           end_pos(position_type p)              { last = ::std::move(p); }
+		reference      at_pos(const position_type& p) const  { return reference(range1.at_pos(p.first), range2.at_pos(p.second)); }
+		position_type& increment_pos(position_type& p) const
+		{
+			if (range2.increment_pos(p.second) == p.run_last)
+			{
+				auto&& key = key2(range2.at_pos(p.run_first));
+				if (range1.increment_pos(p.first) != range1.end_pos() && !comp(key, key1(range1.at_pos(p.first))))
+					p.second = p.run_first;
+				else
+					match(p);
+			}
+			return p;
+		}
+		difference_type distance_pos(position_type p1, const position_type& p2) const
+		{
+			difference_type distance = 0;
+			for (; p1 != p2; increment_pos(p1))
+				++distance;
+			return distance;
+		}
+
+	private:
+		void skewed(::std::false_type /* is_random_access_pair */) { }
+		void skewed(::std::true_type /* is_random_access_pair */)
+		{
+			auto n1 = length(range1), n2 = length(range2);
+			gallop1 = n2 * detail::gallop_ratio <= n1;
+			gallop2 = n1 * detail::gallop_ratio <= n2;
+		}
+
+		// Advances p to the first pair of elements with equal keys at or after it, or to the end.
+		void match(position_type& p) const
+		{
+			auto p_last1 = range1.end_pos();
+			auto p_last2 = range2.end_pos();
+			while (p.first != p_last1 && p.second != p_last2)
+			{
+				auto&& k1 = key1(range1.at_pos(p.first));
+				auto&& k2 = key2(range2.at_pos(p.second));
+				if (comp(k1, k2))
+					p.first = detail::join_lower_bound(range1, p.first, k2, [&](const auto& e, const auto& k) { return comp(key1(e), k); },
+						gallop1, is_random_access_range<ForwardRange1>());
+				else if (comp(k2, k1))
+					p.second = detail::join_lower_bound(range2, p.second, k1, [&](const auto& e, const auto& k) { return comp(key2(e), k); },
+						gallop2, is_random_access_range<ForwardRange2>());
+				else
+				{
+					p.run_first = p.run_last = p.second;
+					while (range2.increment_pos(p.run_last) != p_last2 && !comp(k1, key2(range2.at_pos(p.run_last))))
+						;
+					return;
+				}
+			}
+			p = last;
+		}
+
+		ForwardRange1 range1;
+		ForwardRange2 range2;
+		Key1 key1;
+		Key2 key2;
+		Compare comp;
+		bool gallop1, gallop2;
+		position_type first, last;
+	};
+
+	////////////////////////////////////////////////////////////////
+	// bloom_filter
+	////////////////////////////////////////////////////////////////
+
+	// A blocked Bloom filter over keys of type T.  Each key is hashed to one 64-byte block, a
+	// single cache line, and sets one bit in each of the block's eight words, so a query reads one
+	// line and tests the eight words independently and without branches.
+	// may_contain is true for every inserted key; with the default of 10 bits per key, it is also
+	// true for about 1% of other keys.  may_contain(keys, out) answers for a whole contiguous range
+	// of keys, overlapping the cache misses of neighbouring keys.  r >> semi_join_filter(filter,
+	// key) drops the elements whose keys may_contain rules out; the range refers to the filter,
+	// which must outlive it, so a temporary filter is rejected.
+	template <class T, class Hash>
+	class bloom_filter
+	{
+	public:
+		typedef T key_type;
+		typedef ::std::size_t size_type;
+
+	public:
+		explicit bloom_filter(size_type capacity = 0, size_type bits_per_key = 10, Hash hash = Hash());
+		bloom_filter(const bloom_filter& other);
+		bloom_filter(bloom_filter&&) = default;
+		bloom_filter& operator = (const bloom_filter& other);
+		bloom_filter& operator = (bloom_filter&&) = default;
+
+	public:
+		void insert(const T& key);
+		bool may_contain(const T& key) const;
+		template <class ContiguousRange, class OutputIterator>
+		OutputIterator may_contain(const ContiguousRange& keys, OutputIterator out) const;
+
+	private:
+		static size_type aligned_offset(const ::std::uint64_t* words) noexcept;
+		::std::uint64_t* block(::std::uint64_t h) noexcept;
+		const ::std::uint64_t* block(::std::uint64_t h) const noexcept;
+
+		::std::vector<::std::uint64_t> words;	// the blocks, from the first 64-byte boundary on
+		size_type offset;	// the index of the word at that boundary
+		size_type blocks;
+		Hash hash;
+	};
 }
 
 #include "adapter.inl"
@@ -150,7 +150,7 @@ namespace stdext
 		return transformed_range<Range, detail::range_replace_if_op<Predicate, T>>(::std::forward<Range>(range), ::std::forward<detail::range_replace_if_t<Predicate, T>>(replace));
 	}
 
-	detail::range_unique_t unique()
+	inline detail::range_unique_t unique()
 	{
 		return { };
 	}
@@ -173,6 +173,52 @@ namespace stdext
 		return unique_range<Range, Predicate>(::std::forward<Range>(range), ::std::forward<Predicate>(unique.pred));
 	}
 
+	inline detail::range_distinct_t distinct()
+	{
+		return { nullptr };
+	}
+
+	inline detail::range_distinct_t distinct(scratch_buffer& scratch)
+	{
+		return { &scratch };
+	}
+
+	namespace detail
+	{
+		// The values a distinct_range has yielded, in hash slots that double when they fill up.
+		template <class T>
+		class distinct_set
+		{
+		public:
+			explicit distinct_set(scratch_buffer* scratch) : scratch(scratch) { }
+
+			// Adds value unless an equal value is present, and returns whether it was added.
+			template <class Value>
+			bool insert(Value&& value)
+			{
+				auto h = hash(value);
+				if (slots.full())
+					slots.rehash(::std::max<::std::size_t>(2 * slots.capacity(), 16), hash, scratch, true);
+				auto i = slots.find(h, [&](const T& seen) { return seen == value; });
+				if (slots.occupied(i))
+					return false;
+				slots.emplace(i, h, ::std::forward<Value>(value));
+				return true;
+			}
+
+		private:
+			hash_slots<T> slots;
+			::std::hash<T> hash;
+			scratch_buffer* scratch;
+		};
+	}
+
+	template <class Range>
+	distinct_range<typename ::std::decay<Range>::type> operator >> (Range&& range, const detail::range_distinct_t& distinct)
+	{
+		return distinct_range<typename ::std::decay<Range>::type>(::std::forward<Range>(range), distinct.scratch);
+	}
+
 	inline detail::range_reverse_t reverse()
 	{
 		return { };
@@ -218,4 +264,991 @@ namespace stdext
 	{
 		return partitioned_range<Range, Predicate>(::std::forward<Range>(range), ::std::forward<Predicate>(partition.pred));
 	}
+
+	inline detail::range_split_t split(char delim)
+	{
+		return { delim };
+	}
+
+	inline detail::range_lines_t lines()
+	{
+		return { };
+	}
+
+	namespace detail
+	{
+		// memchr is vectorized by every C runtime we target, so it is the fastest portable way to
+		// scan for a single delimiter.
+		inline const char* find_delimiter(const char* first, const char* last, char delim) noexcept
+		{
+			auto p = static_cast<const char*>(::std::memchr(first, delim, last - first));
+			return p == nullptr ? last : p;
+		}
+
+		template <class Range>
+		::std::pair<const char*, const char*> contiguous_chars(const Range& range)
+		{
+			static_assert(::std::is_pointer<typename range_traits<Range>::position_type>::value
+				&& ::std::is_same<typename ::std::remove_cv<typename range_traits<Range>::value_type>::type, char>::value,
+				"stdext::split: argument is not a contiguous character range");
+			return { range.begin_pos(), range.end_pos() };
+		}
+	}
+
+	template <class Range>
+	split_range operator >> (Range&& range, const detail::range_split_t& split)
+	{
+		auto chars = detail::contiguous_chars(range);
+		return split_range(chars.first, chars.second, split.delim);
+	}
+
+	template <class Range>
+	split_range operator >> (Range&& range, const detail::range_lines_t&)
+	{
+		auto chars = detail::contiguous_chars(range);
+		return split_range(chars.first, chars.second, '\n', true);
+	}
+
+	namespace detail
+	{
+		template <class Range>
+		::std::pair<const void*, ::std::size_t> contiguous_bytes(const Range& range)
+		{
+			static_assert(::std::is_pointer<typename range_traits<Range>::position_type>::value,
+				"stdext::record_view: argument is not a contiguous range");
+			return { range.begin_pos(), (range.end_pos() - range.begin_pos()) * sizeof(typename range_traits<Range>::value_type) };
+		}
+	}
+
+	template <class Record, byte_order Order, class ByteRange>
+	record_range<Record, Order> record_view(const ByteRange& bytes)
+	{
+		auto memory = detail::contiguous_bytes(bytes);
+		return record_range<Record, Order>(memory.first, memory.second);
+	}
+
+	template <class Record, class ByteRange>
+	record_range<Record, byte_order::native> record_view(const ByteRange& bytes)
+	{
+		return record_view<Record, byte_order::native>(bytes);
+	}
+
+	template <class T>
+	typename ::std::enable_if<::std::is_arithmetic<T>::value || ::std::is_enum<T>::value>::type swap_record_bytes(T& value) noexcept
+	{
+		unsigned char bytes[sizeof(T)];
+		::std::memcpy(bytes, &value, sizeof(T));
+		::std::reverse(bytes, bytes + sizeof(T));
+		::std::memcpy(&value, bytes, sizeof(T));
+	}
+
+	template <class T, ::std::size_t N>
+	void swap_record_bytes(T (&values)[N]) noexcept
+	{
+		using ::stdext::swap_record_bytes;
+		for (auto& value : values)
+			swap_record_bytes(value);
+	}
+
+	inline detail::range_stride_t stride(::std::ptrdiff_t n)
+	{
+		return { n };
+	}
+
+	template <class Range>
+	strided_range<Range> operator >> (Range&& range, const detail::range_stride_t& stride)
+	{
+		return strided_range<Range>(::std::forward<Range>(range), stride.n);
+	}
+
+	inline detail::range_chunk_t chunk(::std::ptrdiff_t n)
+	{
+		return { n };
+	}
+
+	template <class Range>
+	chunked_range<Range> operator >> (Range&& range, const detail::range_chunk_t& chunk)
+	{
+		return chunked_range<Range>(::std::forward<Range>(range), chunk.n);
+	}
+
+	inline detail::range_sliding_t sliding(::std::ptrdiff_t width)
+	{
+		return { width };
+	}
+
+	template <class Range>
+	sliding_range<Range> operator >> (Range&& range, const detail::range_sliding_t& sliding)
+	{
+		return sliding_range<Range>(::std::forward<Range>(range), sliding.width);
+	}
+
+	template <class Aggregator>
+	detail::range_window_aggregate_t<typename ::std::decay<Aggregator>::type> window_aggregate(::std::ptrdiff_t width, Aggregator&& agg)
+	{
+		return { width, ::std::forward<Aggregator>(agg) };
+	}
+
+	template <class Range, class Aggregator>
+	aggregated_range<Range, Aggregator> operator >> (Range&& range, detail::range_window_aggregate_t<Aggregator>&& aggregate)
+	{
+		return aggregated_range<Range, Aggregator>(::std::forward<Range>(range), aggregate.width, ::std::move(aggregate.agg));
+	}
+
+	template <class Predicate>
+	detail::range_chunk_by_t<typename ::std::decay<Predicate>::type> chunk_by(Predicate&& pred)
+	{
+		return { ::std::forward<Predicate>(pred) };
+	}
+
+	template <class KeyFunction>
+	detail::range_group_by_key_t<typename ::std::decay<KeyFunction>::type> group_by_key(KeyFunction&& key)
+	{
+		return { ::std::forward<KeyFunction>(key) };
+	}
+
+	template <class Aggregator>
+	detail::range_reduce_groups_t<typename ::std::decay<Aggregator>::type> reduce_groups(Aggregator&& agg)
+	{
+		return { ::std::forward<Aggregator>(agg) };
+	}
+
+	template <class Range, class Predicate>
+	chunk_by_range<typename ::std::decay<Range>::type, Predicate> operator >> (Range&& range, detail::range_chunk_by_t<Predicate>&& chunk)
+	{
+		return chunk_by_range<typename ::std::decay<Range>::type, Predicate>(::std::forward<Range>(range), ::std::move(chunk.pred));
+	}
+
+	template <class Range, class KeyFunction>
+	chunk_by_range<typename ::std::decay<Range>::type, detail::range_group_by_key_op<KeyFunction>> operator >> (Range&& range, detail::range_group_by_key_t<KeyFunction>&& group)
+	{
+		return chunk_by_range<typename ::std::decay<Range>::type, detail::range_group_by_key_op<KeyFunction>>(::std::forward<Range>(range), { ::std::move(group.key) });
+	}
+
+	template <class Range, class Aggregator>
+	reduced_range<typename ::std::decay<Range>::type, Aggregator> operator >> (Range&& range, detail::range_reduce_groups_t<Aggregator>&& reduce)
+	{
+		return reduced_range<typename ::std::decay<Range>::type, Aggregator>(::std::forward<Range>(range), ::std::move(reduce.agg));
+	}
+
+	template <class Filter>
+	detail::range_semi_join_t<Filter, detail::range_semi_join_identity> semi_join_filter(const Filter& filter)
+	{
+		return { &filter, detail::range_semi_join_identity() };
+	}
+
+	template <class Filter, class KeyFunction>
+	detail::range_semi_join_t<Filter, typename ::std::decay<KeyFunction>::type> semi_join_filter(const Filter& filter, KeyFunction&& key)
+	{
+		return { &filter, ::std::forward<KeyFunction>(key) };
+	}
+
+	template <class Range, class Filter, class KeyFunction>
+	filtered_range<typename ::std::decay<Range>::type, detail::range_semi_join_op<Filter, KeyFunction>> operator >> (Range&& range, detail::range_semi_join_t<Filter, KeyFunction>&& semi_join)
+	{
+		return filtered_range<typename ::std::decay<Range>::type, detail::range_semi_join_op<Filter, KeyFunction>>(::std::forward<Range>(range), { semi_join.filter, ::std::move(semi_join.key) });
+	}
+
+	template <class Range, class Compare>
+	detail::range_set_operation_t<typename ::std::decay<Range>::type, detail::set_union_op, Compare> union_with(Range&& range, Compare comp)
+	{
+		return { ::std::forward<Range>(range), ::std::move(comp) };
+	}
+
+	template <class Range, class Compare>
+	detail::range_set_operation_t<typename ::std::decay<Range>::type, detail::set_intersection_op, Compare> intersect_with(Range&& range, Compare comp)
+	{
+		return { ::std::forward<Range>(range), ::std::move(comp) };
+	}
+
+	template <class Range, class Compare>
+	detail::range_set_operation_t<typename ::std::decay<Range>::type, detail::set_difference_op, Compare> difference_with(Range&& range, Compare comp)
+	{
+		return { ::std::forward<Range>(range), ::std::move(comp) };
+	}
+
+	template <class Range, class Compare>
+	detail::range_set_operation_t<typename ::std::decay<Range>::type, detail::set_symmetric_difference_op, Compare> symmetric_difference_with(Range&& range, Compare comp)
+	{
+		return { ::std::forward<Range>(range), ::std::move(comp) };
+	}
+
+	template <class Range1, class Range2, class Operation, class Compare>
+	set_operation_range<typename ::std::decay<Range1>::type, Range2, Operation, Compare> operator >> (Range1&& range1, detail::range_set_operation_t<Range2, Operation, Compare>&& operation)
+	{
+		return set_operation_range<typename ::std::decay<Range1>::type, Range2, Operation, Compare>(::std::forward<Range1>(range1),
+			::std::move(operation.r), ::std::move(operation.comp));
+	}
+
+	template <class... Ranges>
+	zip_range<typename ::std::decay<Ranges>::type...> zip(Ranges&&... ranges)
+	{
+		return zip_range<typename ::std::decay<Ranges>::type...>(::std::forward<Ranges>(ranges)...);
+	}
+
+	template <class Range, class Compare>
+	merged_range<Range, Compare> merge_all(::std::vector<Range> ranges, Compare comp)
+	{
+		return merged_range<Range, Compare>(::std::move(ranges), ::std::move(comp));
+	}
+
+	template <class Range1, class Range2, class... Ranges>
+	typename ::std::enable_if<!detail::is_vector<typename ::std::decay<Range1>::type>::value, merged_range<typename ::std::decay<Range1>::type, ::std::less<>>>::type
+		merge_all(Range1&& range1, Range2&& range2, Ranges&&... ranges)
+	{
+		typedef typename ::std::decay<Range1>::type range_type;
+		return merge_all(::std::vector<range_type> { ::std::forward<Range1>(range1), ::std::forward<Range2>(range2), ::std::forward<Ranges>(ranges)... });
+	}
+
+	template <class Compare>
+	detail::range_top_k_t<Compare> top_k(::std::size_t k, Compare comp)
+	{
+		return { k, ::std::move(comp) };
+	}
+
+	namespace detail
+	{
+		// Replaces the root of a heap of n elements, sifting the new value down into place.  This
+		// costs half the comparisons of a pop_heap followed by a push_heap.
+		template <class Iterator, class T, class Compare>
+		void replace_heap_top(Iterator first, ::std::ptrdiff_t n, T&& value, Compare& comp)
+		{
+			::std::ptrdiff_t hole = 0;
+			for (::std::ptrdiff_t child = 1; child < n; child = 2 * hole + 1)
+			{
+				if (child + 1 < n && comp(first[child], first[child + 1]))
+					++child;
+				if (!comp(value, first[child]))
+					break;
+				first[hole] = ::std::move(first[child]);
+				hole = child;
+			}
+			first[hole] = ::std::forward<T>(value);
+		}
+
+		// Keeps the best k values offered so far as a heap whose root is the worst of them, the
+		// threshold that any further value has to beat.
+		template <class T, class Compare>
+		class top_k_heap
+		{
+		public:
+			top_k_heap(::std::size_t k, Compare comp) : k(k), comp(::std::move(comp)) { values.reserve(k); }
+
+			bool full() const { return values.size() == k; }
+			const T& threshold() const { return values.front(); }
+
+			template <class Value>
+			void offer(Value&& value)
+			{
+				if (!full())
+				{
+					values.push_back(::std::forward<Value>(value));
+					::std::push_heap(values.begin(), values.end(), comp);
+				}
+				else if (comp(value, values.front()))
+					replace_heap_top(values.begin(), static_cast<::std::ptrdiff_t>(k), T(::std::forward<Value>(value)), comp);
+			}
+
+			::std::vector<T> sorted()
+			{
+				::std::sort_heap(values.begin(), values.end(), comp);
+				return ::std::move(values);
+			}
+
+		private:
+			::std::vector<T> values;
+			::std::size_t k;
+			Compare comp;
+		};
+
+		// Contiguous arithmetic values compared by < or > are screened against the threshold a
+		// block at a time; most blocks of a long input hold nothing that beats it and are skipped
+		// whole.  The screening loop is a plain compare-and-or reduction, which GCC vectorizes from
+		// -O2, so it is written once for every element type rather than in intrinsics per type.
+		template <class Range, class Compare,
+			class Position = typename range_traits<Range>::position_type, class T = typename range_traits<Range>::value_type>
+		struct is_top_k_filterable : ::std::integral_constant<bool,
+			::std::is_base_of<iterator_range<Position>, Range>::value
+			&& (::std::is_pointer<Position>::value || ::std::is_same<Position, typename ::std::vector<T>::iterator>::value
+				|| ::std::is_same<Position, typename ::std::vector<typename ::std::remove_const<T>::type>::const_iterator>::value)
+			&& ::std::is_arithmetic<T>::value
+			&& (::std::is_same<Compare, ::std::less<>>::value || ::std::is_same<Compare, ::std::greater<>>::value)>
+		{
+		};
+
+		const ::std::ptrdiff_t top_k_block_size = 64;
+
+		template <class T, class Range, class Compare>
+		void select_top_k(top_k_heap<T, Compare>& heap, const Range& range, Compare, ::std::false_type /* is_top_k_filterable */)
+		{
+			for (auto p = range.begin_pos(), p_last = range.end_pos(); p != p_last; range.increment_pos(p))
+				heap.offer(range.at_pos(p));
+		}
+
+		template <class T, class Range, class Compare>
+		void select_top_k(top_k_heap<T, Compare>& heap, const Range& range, Compare comp, ::std::true_type /* is_top_k_filterable */)
+		{
+			if (range.begin_pos() == range.end_pos())
+				return;
+			auto first = &range.at_pos(range.begin_pos()), last = first + range.distance_pos(range.begin_pos(), range.end_pos());
+			for (; first != last && !heap.full(); ++first)
+				heap.offer(*first);
+			for (; last - first >= top_k_block_size; first += top_k_block_size)
+			{
+				T threshold = heap.threshold();
+				unsigned hits = 0;
+				for (::std::ptrdiff_t i = 0; i != top_k_block_size; ++i)
+					hits |= comp(first[i], threshold);
+				if (hits != 0)
+				{
+					for (::std::ptrdiff_t i = 0; i != top_k_block_size; ++i)
+						heap.offer(first[i]);
+				}
+			}
+			for (; first != last; ++first)
+				heap.offer(*first);
+		}
+	}
+
+	template <class Range, class Compare>
+	top_k_range<typename ::std::remove_cv<typename range_traits<typename ::std::decay<Range>::type>::value_type>::type>
+		operator >> (Range&& range, detail::range_top_k_t<Compare>&& top)
+	{
+		typedef typename ::std::decay<Range>::type range_type;
+		typedef typename ::std::remove_cv<typename range_traits<range_type>::value_type>::type value_type;
+		detail::top_k_heap<value_type, Compare> heap(top.k, top.comp);
+		if (top.k != 0)
+			detail::select_top_k(heap, range, top.comp, detail::is_top_k_filterable<range_type, Compare>());
+		return top_k_range<value_type>(heap.sorted());
+	}
+
+	inline count_aggregator group_count()
+	{
+		return { };
+	}
+
+	template <class Operation>
+	sum_aggregator<Operation> group_sum(Operation op)
+	{
+		return sum_aggregator<Operation>(::std::move(op));
+	}
+
+	template <class Operation>
+	min_aggregator<Operation, ::std::less<>> group_min(Operation op)
+	{
+		return min_aggregator<Operation, ::std::less<>>(::std::move(op), ::std::less<>());
+	}
+
+	template <class Operation>
+	min_aggregator<Operation, ::std::greater<>> group_max(Operation op)
+	{
+		return min_aggregator<Operation, ::std::greater<>>(::std::move(op), ::std::greater<>());
+	}
+
+	template <class T, class Operation>
+	fold_aggregator<T, Operation> group_fold(T init, Operation op)
+	{
+		return fold_aggregator<T, Operation>(::std::move(init), ::std::move(op));
+	}
+
+	namespace detail
+	{
+		// Inputs below this length per worker are grouped on one thread.
+		const ::std::ptrdiff_t parallel_group_threshold = 1 << 16;
+
+		// parallel_group_aggregate splits the input into this many partitions by hash, so that no
+		// two workers ever see the same key and each partition's table is a fraction of the whole.
+		const ::std::size_t group_partition_bits = 8;
+
+		// The groups found so far, with the key and aggregate states of each in one hash slot.  The
+		// slots grow in the scratch buffer if there is one, or else on the heap; add fails only
+		// for a new key once the scratch buffer is used up.
+		template <class Range, class KeyFunction, class... Aggregators>
+		class group_table
+		{
+		public:
+			typedef typename range_traits<Range>::reference reference;
+			typedef group_key_t<Range, KeyFunction> key_type;
+			typedef group_row_t<Range, KeyFunction, Aggregators...> row_type;
+			typedef ::std::index_sequence_for<Aggregators...> indices;
+
+			struct group
+			{
+				key_type key;
+				::std::tuple<aggregate_state_t<Aggregators, reference>...> states;
+			};
+
+		public:
+			group_table(KeyFunction& key, const ::std::tuple<Aggregators...>& aggs, scratch_buffer* scratch)
+				: key(key), aggs(aggs), scratch(scratch)
+			{
+			}
+
+			bool add(reference e)
+			{
+				auto&& k = key(e);
+				return add(k, hash(k), ::std::forward<reference>(e));
+			}
+
+			bool add(const key_type& k, ::std::size_t h, reference e)
+			{
+				::std::size_t i = 0;
+				if (slots)
+				{
+					i = slots.find(h, [&](const group& g) { return g.key == k; });
+					if (slots.occupied(i))
+					{
+						push(slots[i].states, e, indices());
+						return true;
+					}
+				}
+				if (slots.full())
+				{
+					auto hash_of = [this](const group& g) { return hash(g.key); };
+					if (!slots.rehash(::std::max<::std::size_t>(2 * slots.capacity(), 16), hash_of, scratch, scratch == nullptr || slots.size() == 0))
+						return false;
+					i = slots.find(h, [](const group&) { return false; });
+				}
+				start(i, h, k, e, indices());
+				return true;
+			}
+
+			void rows(::std::vector<row_type>& out) const
+			{
+				for (::std::size_t i = 0; i != slots.capacity(); ++i)
+				{
+					if (slots.occupied(i))
+						row(out, slots[i], indices());
+				}
+			}
+
+		private:
+			template <::std::size_t... I>
+			void start(::std::size_t i, ::std::size_t h, const key_type& k, reference e, ::std::index_sequence<I...>)
+			{
+				slots.emplace(i, h, group { k, ::std::tuple<aggregate_state_t<Aggregators, reference>...>(::std::get<I>(aggs).start(e)...) });
+			}
+
+			template <::std::size_t... I>
+			void push(::std::tuple<aggregate_state_t<Aggregators, reference>...>& states, reference e, ::std::index_sequence<I...>) const
+			{
+				int expand[] = { 0, (::std::get<I>(aggs).push(::std::get<I>(states), e), 0)... };
+				(void)expand;
+			}
+
+			template <::std::size_t... I>
+			void row(::std::vector<row_type>& out, const group& g, ::std::index_sequence<I...>) const
+			{
+				out.emplace_back(g.key, ::std::get<I>(aggs).value(::std::get<I>(g.states))...);
+			}
+
+			KeyFunction& key;
+			const ::std::tuple<Aggregators...>& aggs;
+			scratch_buffer* scratch;
+			::std::hash<key_type> hash;
+			hash_slots<group> slots;
+		};
+
+		// The partition of a hash at a level of partitioning, group_partition_bits of the mixed
+		// hash below the tag bits and those of the levels above.
+		inline ::std::size_t group_partition(::std::size_t h, unsigned level) noexcept
+		{
+			auto shift = 57 - group_partition_bits * (::std::min(level, 5u) + 1);
+			return static_cast<::std::size_t>(mix_hash(h) >> shift) & ((::std::size_t(1) << group_partition_bits) - 1);
+		}
+
+		// Groups the elements at the given positions, or all of them if there are none, in a table
+		// in the scratch buffer.  The positions of elements whose groups did not fit are spilled
+		// to buckets by the next bits of their hash, and each bucket is grouped by a further pass
+		// with the whole buffer, so no pass rereads the elements of groups already done.
+		template <class Range, class KeyFunction, class... Aggregators>
+		void group_pass(const Range& range, KeyFunction& key, const ::std::tuple<Aggregators...>& aggs, scratch_buffer& scratch,
+			const ::std::vector<typename range_traits<Range>::position_type>* positions, unsigned level,
+			::std::vector<group_row_t<Range, KeyFunction, Aggregators...>>& rows)
+		{
+			typedef typename range_traits<Range>::position_type position_type;
+			::std::vector<::std::vector<position_type>> buckets;
+			{
+				scratch_scope scope(scratch);
+				group_table<Range, KeyFunction, Aggregators...> table(key, aggs, &scratch);
+				::std::hash<group_key_t<Range, KeyFunction>> hash;
+				auto add = [&](const position_type& p)
+				{
+					auto&& e = range.at_pos(p);
+					auto&& k = key(e);
+					auto h = hash(k);
+					if (!table.add(k, h, ::std::forward<decltype(e)>(e)))
+					{
+						if (buckets.empty())
+							buckets.resize(::std::size_t(1) << group_partition_bits);
+						buckets[group_partition(h, level)].push_back(p);
+					}
+				};
+				if (positions == nullptr)
+				{
+					for (auto p = range.begin_pos(), last = range.end_pos(); p != last; range.increment_pos(p))
+						add(p);
+				}
+				else
+				{
+					for (auto& p : *positions)
+						add(p);
+				}
+				table.rows(rows);
+			}
+			for (auto& bucket : buckets)
+			{
+				if (!bucket.empty())
+					group_pass(range, key, aggs, scratch, &bucket, level + 1, rows);
+			}
+		}
+
+		template <class Range, class KeyFunction, class... Aggregators>
+		::std::vector<group_row_t<Range, KeyFunction, Aggregators...>>
+			group_aggregate(const Range& range, KeyFunction& key, const ::std::tuple<Aggregators...>& aggs)
+		{
+			::std::vector<group_row_t<Range, KeyFunction, Aggregators...>> rows;
+			group_table<Range, KeyFunction, Aggregators...> table(key, aggs, nullptr);
+			for (auto p = range.begin_pos(), last = range.end_pos(); p != last; range.increment_pos(p))
+				table.add(range.at_pos(p));
+			table.rows(rows);
+			return rows;
+		}
+
+		// The elements of a random access range rearranged so that each partition is contiguous.
+		// Trivially copyable elements are copied into uninitialized storage, since grouping them
+		// from there reads memory in order; other elements are reached through their indices.
+		template <class Range, class T = typename ::std::remove_cv<typename range_traits<Range>::value_type>::type,
+			bool Copy = ::std::is_trivially_copyable<T>::value && ::std::is_reference<typename range_traits<Range>::reference>::value>
+		class partition_buffer
+		{
+		public:
+			partition_buffer(range_iterator<Range> first, ::std::size_t n) : first(first), order(n) { }
+
+			void put(::std::size_t j, ::std::size_t i) noexcept { order[j] = i; }
+			typename range_traits<Range>::reference operator [] (::std::size_t j) const { return first[order[j]]; }
+
+		private:
+			range_iterator<Range> first;
+			::std::vector<::std::size_t> order;
+		};
+
+		template <class Range, class T>
+		class partition_buffer<Range, T, true>
+		{
+		public:
+			partition_buffer(range_iterator<Range> first, ::std::size_t n)
+				: first(first), values(static_cast<T*>(::operator new(n * sizeof(T))))
+			{
+			}
+			partition_buffer(const partition_buffer&) = delete;
+			partition_buffer& operator = (const partition_buffer&) = delete;
+			~partition_buffer() { ::operator delete(values); }
+
+			void put(::std::size_t j, ::std::size_t i) noexcept { ::new (static_cast<void*>(values + j)) T(first[i]); }
+			T& operator [] (::std::size_t j) const noexcept { return values[j]; }
+
+		private:
+			range_iterator<Range> first;
+			T* values;
+		};
+
+		// Each worker hashes the keys of its slice and counts them by partition, then puts its
+		// elements and their hashes into buffers so that each partition is contiguous, and then
+		// groups whole partitions into tables of their own.  A partition's table is a fraction of
+		// one table over all the keys, so it stays in cache for longer, and it needs no locking
+		// since its keys occur in no other partition.
+		template <class Range, class KeyFunction, class... Aggregators>
+		::std::vector<group_row_t<Range, KeyFunction, Aggregators...>>
+			partitioned_group_aggregate(const Range& range, KeyFunction& key, const ::std::tuple<Aggregators...>& aggs, unsigned workers)
+		{
+			typedef group_row_t<Range, KeyFunction, Aggregators...> row_type;
+			typedef range_iterator<Range> iterator;
+			const ::std::size_t partitions = ::std::size_t(1) << group_partition_bits;
+
+			iterator first(range, range.begin_pos());
+			auto n = static_cast<::std::size_t>(length(range));
+			::std::vector<::std::size_t> hashes(n), buffer_hashes(n), offsets(workers * partitions);
+			partition_buffer<Range> buffer(first, n);
+			auto slice = [&](unsigned worker) { return ::std::make_pair(n * worker / workers, n * (worker + 1) / workers); };
+
+			for_each_worker(workers, [&](unsigned worker)
+			{
+				::std::hash<group_key_t<Range, KeyFunction>> hash;
+				auto count = &offsets[worker * partitions];
+				auto bounds = slice(worker);
+				for (auto i = bounds.first; i != bounds.second; ++i)
+					++count[group_partition(hashes[i] = hash(key(first[i])), 0)];
+			});
+
+			::std::vector<::std::size_t> starts(partitions + 1);
+			::std::size_t sum = 0;
+			for (::std::size_t p = 0; p != partitions; ++p)
+			{
+				starts[p] = sum;
+				for (unsigned worker = 0; worker != workers; ++worker)
+				{
+					auto count = offsets[worker * partitions + p];
+					offsets[worker * partitions + p] = sum;
+					sum += count;
+				}
+			}
+			starts[partitions] = sum;
+
+			for_each_worker(workers, [&](unsigned worker)
+			{
+				auto offset = &offsets[worker * partitions];
+				auto bounds = slice(worker);
+				for (auto i = bounds.first; i != bounds.second; ++i)
+				{
+					auto j = offset[group_partition(hashes[i], 0)]++;
+					buffer.put(j, i);
+					buffer_hashes[j] = hashes[i];
+				}
+			});
+
+			::std::vector<::std::vector<row_type>> partition_rows(partitions);
+			for_each_worker(workers, [&](unsigned worker)
+			{
+				for (::std::size_t p = worker; p < partitions; p += workers)
+				{
+					group_table<Range, KeyFunction, Aggregators...> table(key, aggs, nullptr);
+					for (auto j = starts[p]; j != starts[p + 1]; ++j)
+					{
+						auto&& e = buffer[j];
+						table.add(key(e), buffer_hashes[j], ::std::forward<decltype(e)>(e));
+					}
+					table.rows(partition_rows[p]);
+				}
+			});
+
+			::std::size_t groups = 0;
+			for (auto& part : partition_rows)
+				groups += part.size();
+			::std::vector<row_type> rows;
+			rows.reserve(groups);
+			for (auto& part : partition_rows)
+				rows.insert(rows.end(), ::std::make_move_iterator(part.begin()), ::std::make_move_iterator(part.end()));
+			return rows;
+		}
+
+		// The number of distinct keys among the first parallel_group_threshold elements, an
+		// estimate of whether the groups would outgrow the cache.
+		template <class Range, class KeyFunction>
+		::std::size_t sample_group_count(const Range& range, KeyFunction& key)
+		{
+			typedef group_key_t<Range, KeyFunction> key_type;
+			auto n = ::std::min<::std::ptrdiff_t>(length(range), parallel_group_threshold);
+			hash_slots<key_type> keys(hash_capacity(static_cast<::std::size_t>(n)), nullptr, true);
+			::std::hash<key_type> hash;
+			auto p = range.begin_pos();
+			for (::std::ptrdiff_t i = 0; i != n; ++i, range.increment_pos(p))
+			{
+				auto&& k = key(range.at_pos(p));
+				auto h = hash(k);
+				auto slot = keys.find(h, [&](const key_type& other) { return other == k; });
+				if (!keys.occupied(slot))
+					keys.emplace(slot, h, k);
+			}
+			return keys.size();
+		}
+
+		// Partitioning costs three times a single table over the same elements while that table
+		// stays in cache, and only about a fifth more once it does not, so the partitioned path is
+		// taken only when nearly every key in the sample is distinct, some 250000 groups or more
+		// for evenly spread keys.
+		const ::std::size_t parallel_group_min_sample_groups = ::std::size_t(parallel_group_threshold) / 8 * 7;
+
+		template <class Range, class KeyFunction, class... Aggregators>
+		::std::vector<group_row_t<Range, KeyFunction, Aggregators...>>
+			parallel_group_aggregate(const Range& range, KeyFunction& key, const ::std::tuple<Aggregators...>& aggs, unsigned workers)
+		{
+			workers = static_cast<unsigned>(::std::min<::std::ptrdiff_t>(workers, length(range) / parallel_group_threshold));
+			if (workers < 2 || sample_group_count(range, key) < parallel_group_min_sample_groups)
+				return group_aggregate(range, key, aggs);
+			return partitioned_group_aggregate(range, key, aggs, workers);
+		}
+	}
+
+	// Groups the elements of range by key(e) and computes the aggregates of each group in one
+	// pass, keeping a hash table of groups whose slots hold the key and aggregate states inline.
+	template <class Range, class KeyFunction, class... Aggregators>
+	grouped_range<detail::group_row_t<Range, KeyFunction, Aggregators...>> group_aggregate(const Range& range, KeyFunction key, Aggregators... aggs)
+	{
+		::std::tuple<Aggregators...> aggregators(::std::move(aggs)...);
+		return grouped_range<detail::group_row_t<Range, KeyFunction, Aggregators...>>(detail::group_aggregate(range, key, aggregators));
+	}
+
+	// As above, with the table kept in the scratch buffer.  When it is full, elements of groups
+	// not yet in it are spilled by hash and grouped by later passes over the forward range.
+	template <class Range, class KeyFunction, class... Aggregators>
+	grouped_range<detail::group_row_t<Range, KeyFunction, Aggregators...>> group_aggregate(const Range& range, KeyFunction key, scratch_buffer& scratch, Aggregators... aggs)
+	{
+		static_assert(is_forward_range<Range>::value, "stdext::group_aggregate: spilling needs a forward range");
+		::std::tuple<Aggregators...> aggregators(::std::move(aggs)...);
+		::std::vector<detail::group_row_t<Range, KeyFunction, Aggregators...>> rows;
+		detail::group_pass(range, key, aggregators, scratch, nullptr, 0, rows);
+		return grouped_range<detail::group_row_t<Range, KeyFunction, Aggregators...>>(::std::move(rows));
+	}
+
+	// As group_aggregate, with the random access range partitioned by hash across the hardware
+	// threads.  key and the aggregators are called concurrently.  Partitioning makes two extra
+	// passes, so it pays off only for long ranges with many groups, whose single table would not
+	// stay in cache; a sample of the range decides, and other ranges are grouped on one thread.
+	template <class Range, class KeyFunction, class... Aggregators>
+	grouped_range<detail::group_row_t<Range, KeyFunction, Aggregators...>> parallel_group_aggregate(const Range& range, KeyFunction key, Aggregators... aggs)
+	{
+		static_assert(is_random_access_range<Range>::value, "stdext::parallel_group_aggregate: argument is not a random access range");
+		::std::tuple<Aggregators...> aggregators(::std::move(aggs)...);
+		return grouped_range<detail::group_row_t<Range, KeyFunction, Aggregators...>>(
+			detail::parallel_group_aggregate(range, key, aggregators, detail::hardware_threads()));
+	}
+
+	namespace detail
+	{
+		// A hash multimap from the keys of a build range to the positions of its elements.  Each
+		// slot holds a key and the position of its first row, so a probe for a key that occurs once
+		// reads only the slot and the row.  Further rows with the same key are chained through next
+		// in the order of the build range.
+		template <class BuildRange, class BuildKey>
+		class join_table
+		{
+		public:
+			typedef group_key_t<BuildRange, BuildKey> key_type;
+			typedef typename range_traits<BuildRange>::position_type position_type;
+
+			struct entry
+			{
+				key_type key;
+				position_type first;
+				::std::size_t more;
+			};
+
+			join_table(BuildRange range, BuildKey key) : range(::std::move(range)), key(::std::move(key))
+			{
+				auto hash_of = [this](const entry& e) { return hash(e.key); };
+				auto& r = this->range;
+				for (auto p = r.begin_pos(), p_last = r.end_pos(); p != p_last; r.increment_pos(p))
+				{
+					auto&& k = this->key(r.at_pos(p));
+					auto h = hash(k);
+					if (slots.full())
+						slots.rehash(::std::max<::std::size_t>(2 * slots.capacity(), 16), hash_of, nullptr, true);
+					auto i = slots.find(h, [&](const entry& e) { return e.key == k; });
+					if (!slots.occupied(i))
+					{
+						slots.emplace(i, h, entry { key_type(::std::forward<decltype(k)>(k)), p, join_end });
+						continue;
+					}
+					auto& e = slots[i];
+					rows.push_back(p);
+					next.push_back(e.more);
+					e.more = rows.size() - 1;
+				}
+
+				// Further rows were pushed onto the front of their chains, so reverse the chains to
+				// restore build order.
+				for (::std::size_t i = 0; !next.empty() && i != slots.capacity(); ++i)
+				{
+					if (!slots.occupied(i))
+						continue;
+					auto row = slots[i].more, reversed = join_end;
+					while (row != join_end)
+					{
+						auto following = next[row];
+						next[row] = reversed;
+						reversed = row;
+						row = following;
+					}
+					slots[i].more = reversed;
+				}
+			}
+
+			// The entry whose key equals k, or nullptr.
+			template <class Key>
+			const entry* find(const Key& k) const
+			{
+				if (!slots)
+					return nullptr;
+				auto i = slots.find(hash(k), [&](const entry& e) { return e.key == k; });
+				return slots.occupied(i) ? &slots[i] : nullptr;
+			}
+
+			const position_type& row(::std::size_t i) const noexcept { return rows[i]; }
+			::std::size_t next_row(::std::size_t i) const noexcept   { return next[i]; }
+			const BuildRange& build() const noexcept                 { return range; }
+
+		private:
+			BuildRange range;
+			BuildKey key;
+			::std::hash<key_type> hash;
+			hash_slots<entry> slots;
+			::std::vector<position_type> rows;
+			::std::vector<::std::size_t> next;
+		};
+	}
+
+	template <class BuildRange, class ProbeRange, class BuildKey, class ProbeKey>
+	hash_join_range<typename ::std::decay<BuildRange>::type, typename ::std::decay<ProbeRange>::type, BuildKey, ProbeKey>
+		join_hash(BuildRange&& build, ProbeRange&& probe, BuildKey build_key, ProbeKey probe_key)
+	{
+		return hash_join_range<typename ::std::decay<BuildRange>::type, typename ::std::decay<ProbeRange>::type, BuildKey, ProbeKey>(
+			::std::forward<BuildRange>(build), ::std::forward<ProbeRange>(probe), ::std::move(build_key), ::std::move(probe_key));
+	}
+
+	template <class Range1, class Range2, class Key1, class Key2, class Compare>
+	merge_join_range<typename ::std::decay<Range1>::type, typename ::std::decay<Range2>::type, Key1, Key2, Compare>
+		join_merge(Range1&& range1, Range2&& range2, Key1 key1, Key2 key2, Compare comp)
+	{
+		return merge_join_range<typename ::std::decay<Range1>::type, typename ::std::decay<Range2>::type, Key1, Key2, Compare>(
+			::std::forward<Range1>(range1), ::std::forward<Range2>(range2), ::std::move(key1), ::std::move(key2), ::std::move(comp));
+	}
+
+	namespace detail
+	{
+		// Multipliers that pick the bit set in each word of a bloom_filter block from one 32-bit
+		// hash, so that the eight bits are independent of each other.
+		const ::std::uint32_t bloom_salts[8] = {
+			0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+		};
+
+		inline ::std::uint64_t bloom_bit(::std::uint64_t h, ::std::size_t i) noexcept
+		{
+			return ::std::uint64_t(1) << ((static_cast<::std::uint32_t>(h) * bloom_salts[i]) >> 26);
+		}
+
+		// Whether the block has every bit of hash h set.  Every word is tested, with no early exit.
+		// With AVX2, the eight bits are picked and tested in two 256-bit halves; SSE2 has no
+		// shift by a different count in each lane, so other targets test word by word, which
+		// compilers keep scalar.
+		inline bool bloom_test(const ::std::uint64_t* block, ::std::uint64_t h) noexcept
+		{
+#if defined(__AVX2__)
+			auto salts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bloom_salts));
+			auto shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(h)), salts), 26);
+			auto ones = _mm256_set1_epi64x(1);
+			auto low = _mm256_sllv_epi64(ones, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shifts)));
+			auto high = _mm256_sllv_epi64(ones, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shifts, 1)));
+			auto words = reinterpret_cast<const __m256i*>(block);
+			auto missing = _mm256_or_si256(_mm256_andnot_si256(_mm256_load_si256(words), low),
+										   _mm256_andnot_si256(_mm256_load_si256(words + 1), high));
+			return _mm256_testz_si256(missing, missing) != 0;
+#else
+			::std::uint64_t missing = 0;
+			for (::std::size_t i = 0; i != 8; ++i)
+				missing |= ~block[i] & bloom_bit(h, i);
+			return missing == 0;
+#endif
+		}
+
+		// Keys that bloom_filter::may_contain(keys, out) hashes, and whose blocks it prefetches,
+		// before testing any of them.
+		const ::std::size_t bloom_batch = 16;
+	}
+
+	template <class T, class Hash>
+	bloom_filter<T, Hash>::bloom_filter(size_type capacity, size_type bits_per_key, Hash hash)
+		: blocks(::std::max<size_type>((capacity * bits_per_key + 511) / 512, 1)), hash(::std::move(hash))
+	{
+		words.resize(8 * blocks + 7);
+		offset = aligned_offset(words.data());
+	}
+
+	// A copy's words may start at another offset from a 64-byte boundary, so the blocks are
+	// copied to its own first boundary rather than word for word.  A move keeps the words.
+	template <class T, class Hash>
+	bloom_filter<T, Hash>::bloom_filter(const bloom_filter& other)
+		: words(other.words.size()), offset(aligned_offset(words.data())), blocks(other.blocks), hash(other.hash)
+	{
+		::std::copy_n(other.words.data() + other.offset, 8 * blocks, words.data() + offset);
+	}
+
+	template <class T, class Hash>
+	bloom_filter<T, Hash>& bloom_filter<T, Hash>::operator = (const bloom_filter& other)
+	{
+		bloom_filter copy(other);
+		return *this = ::std::move(copy);
+	}
+
+	template <class T, class Hash>
+	void bloom_filter<T, Hash>::insert(const T& key)
+	{
+		auto h = detail::mix_hash(hash(key));
+		auto b = block(h);
+		for (::std::size_t i = 0; i != 8; ++i)
+			b[i] |= detail::bloom_bit(h, i);
+	}
+
+	template <class T, class Hash>
+	bool bloom_filter<T, Hash>::may_contain(const T& key) const
+	{
+		auto h = detail::mix_hash(hash(key));
+		return detail::bloom_test(block(h), h);
+	}
+
+	// A batch of keys is hashed and its blocks prefetched before the first is tested, so that
+	// the batch's cache misses overlap rather than follow one another.
+	template <class T, class Hash>
+	template <class ContiguousRange, class OutputIterator>
+	OutputIterator bloom_filter<T, Hash>::may_contain(const ContiguousRange& keys, OutputIterator out) const
+	{
+		static_assert(detail::is_contiguous<ContiguousRange>::value, "stdext::bloom_filter::may_contain: keys are not a contiguous range");
+		auto n = static_cast<size_type>(length(keys));
+		if (n == 0)
+			return out;
+
+		const auto* first = &keys.at_pos(keys.begin_pos());
+		::std::uint64_t hashes[detail::bloom_batch];
+		for (size_type i = 0; i < n; i += detail::bloom_batch)
+		{
+			auto m = ::std::min(detail::bloom_batch, n - i);
+			for (size_type j = 0; j != m; ++j)
+			{
+				hashes[j] = detail::mix_hash(hash(first[i + j]));
+				detail::prefetch(block(hashes[j]));
+			}
+			for (size_type j = 0; j != m; ++j)
+				*out++ = detail::bloom_test(block(hashes[j]), hashes[j]);
+		}
+		return out;
+	}
+
+	template <class T, class Hash>
+	typename bloom_filter<T, Hash>::size_type bloom_filter<T, Hash>::aligned_offset(const ::std::uint64_t* words) noexcept
+	{
+		return (64 - reinterpret_cast<::std::uintptr_t>(words) % 64) % 64 / sizeof(::std::uint64_t);
+	}
+
+	template <class T, class Hash>
+	::std::uint64_t* bloom_filter<T, Hash>::block(::std::uint64_t h) noexcept
+	{
+		return const_cast<::std::uint64_t*>(static_cast<const bloom_filter&>(*this).block(h));
+	}
+
+	// The high half of the hash scales to a block index, so the number of blocks need not be a
+	// power of two; the low half picks the bits.
+	template <class T, class Hash>
+	const ::std::uint64_t* bloom_filter<T, Hash>::block(::std::uint64_t h) const noexcept
+	{
+		auto i = static_cast<size_type>(((h >> 32) * blocks) >> 32);
+		return words.data() + offset + 8 * i;
+	}
+
+	template <class ForwardRange>
+	bloom_filter<typename ::std::remove_cv<typename range_traits<ForwardRange>::value_type>::type> make_bloom_filter(const ForwardRange& keys)
+	{
+		bloom_filter<typename ::std::remove_cv<typename range_traits<ForwardRange>::value_type>::type> filter(static_cast<::std::size_t>(length(keys)));
+		for (auto p = keys.begin_pos(), last = keys.end_pos(); p != last; keys.increment_pos(p))
+			filter.insert(keys.at_pos(p));
+		return filter;
+	}
+
+	template <class ForwardRange, class KeyFunction>
+	bloom_filter<detail::group_key_t<ForwardRange, KeyFunction>> make_bloom_filter(const ForwardRange& range, KeyFunction key)
+	{
+		bloom_filter<detail::group_key_t<ForwardRange, KeyFunction>> filter(static_cast<::std::size_t>(length(range)));
+		for (auto p = range.begin_pos(), last = range.end_pos(); p != last; range.increment_pos(p))
+			filter.insert(key(range.at_pos(p)));
+		return filter;
+	}
 }
\ No newline at end of file
@@ -5,10 +5,61 @@
 #include <range.h>
 #include <initializer_list>
 #include <cstddef>	// for std::size_t
+#include <memory>	// for std::align
+#include <vector>
 
 
 namespace stdext
 {
+	namespace detail
+	{
+		class scratch_scope;
+	}
+
+	// A monotonic arena over memory supplied by the caller.  Algorithms that take a scratch_buffer
+	// carve their temporary storage from it rather than from the heap and give it back before they
+	// return; when it is too small they fall back to strategies that need less memory.
+	class scratch_buffer
+	{
+	public:
+		scratch_buffer(void* memory, std::size_t size) noexcept
+			: first(static_cast<unsigned char*>(memory)), next(first), last(first + size) { }
+		scratch_buffer(const scratch_buffer&) = delete;
+		scratch_buffer& operator = (const scratch_buffer&) = delete;
+
+	public:
+		// Returns uninitialized storage for n objects of type T, or nullptr if not enough remains.
+		template <class T>
+		T* allocate(std::size_t n) noexcept
+		{
+			void* p = next;
+			std::size_t space = last - next;
+			if (n > space / sizeof(T) || !std::align(alignof(T), n * sizeof(T), p, space))
+				return nullptr;
+			next = static_cast<unsigned char*>(p) + n * sizeof(T);
+			return static_cast<T*>(p);
+		}
+
+		// The number of objects of type T that could still be allocated at once.
+		template <class T>
+		std::size_t available() const noexcept
+		{
+			void* p = next;
+			std::size_t space = last - next;
+			return std::align(alignof(T), 0, p, space) ? space / sizeof(T) : 0;
+		}
+
+		// Discards everything allocated so far.
+		void release() noexcept { next = first; }
+
+	private:
+		friend class detail::scratch_scope;
+
+		unsigned char* first;
+		unsigned char* next;
+		unsigned char* last;
+	};
+
 	// 25.2, non-modifying sequence operations:
 	template <class InputRange, class Predicate>
 	bool all_of(const InputRange& range, Predicate pred);
@@ -70,6 +121,10 @@ namespace stdext
 	template<class InputRange1, class InputRange2, class BinaryPredicate>
 	typename std::enable_if<is_range<InputRange2>::value, bool>::type
 		equal(const InputRange1& range1, const InputRange2& range2, BinaryPredicate pred);
+	template<class T, class U, std::size_t N>
+	bool equal(const fixed_range<T, N>& range1, const fixed_range<U, N>& range2);
+	template<class T, class U, std::size_t N, class BinaryPredicate>
+	bool equal(const fixed_range<T, N>& range1, const fixed_range<U, N>& range2, BinaryPredicate pred);
 
 	template<class ForwardRange1, class ForwardIterator2>
 	typename std::enable_if<!is_range<ForwardIterator2>::value, bool>::type
@@ -83,6 +138,12 @@ namespace stdext
 	template<class ForwardRange1, class ForwardRange2, class BinaryPredicate>
 	typename std::enable_if<is_range<ForwardRange2>::value, bool>::type
 		is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, BinaryPredicate pred);
+	template<class ForwardRange1, class ForwardRange2>
+	bool is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, scratch_buffer& scratch);
+	template<class ForwardRange1, class ForwardRange2, class Compare>
+	bool is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, Compare comp, scratch_buffer& scratch);
+	template<class ForwardRange1, class ForwardRange2, class Hash, class KeyEqual>
+	bool is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, Hash hash, KeyEqual eq, scratch_buffer& scratch);
 
 	template<class ForwardRange1, class ForwardRange2>
 	typename range_traits<ForwardRange1>::position_type search(const ForwardRange1& range1, const ForwardRange2& range2);
@@ -130,6 +191,8 @@ namespace stdext
 
 	template<class ForwardRange, class T>
 	void fill(const ForwardRange& range, const T& value);
+	template<class T, std::size_t N, class U>
+	void fill(const fixed_range<T, N>& range, const U& value);
 	template<class OutputRange, class Size, class T>
 	typename range_traits<OutputRange>::position_type fill_n(OutputRange first, Size n, const T& value);
 
@@ -180,6 +243,8 @@ namespace stdext
 	typename range_traits<ForwardRange>::position_type partition(const ForwardRange& range, Predicate pred);
 	template<class BidirectionalRange, class Predicate>
 	typename range_traits<BidirectionalRange>::position_type stable_partition(const BidirectionalRange& range, Predicate pred);
+	template<class BidirectionalRange, class Predicate>
+	typename range_traits<BidirectionalRange>::position_type stable_partition(const BidirectionalRange& range, Predicate pred, scratch_buffer& scratch);
 	template <class InputRange, class OutputIterator1, class OutputIterator2, class Predicate>
 	std::pair<OutputIterator1, OutputIterator2> partition_copy(const InputRange& range, OutputIterator1 out_true, OutputIterator2 out_false, Predicate pred);
 	template<class ForwardRange, class Predicate>
@@ -191,11 +256,42 @@ namespace stdext
 	void sort(const RandomAccessRange& range);
 	template<class RandomAccessRange, class Compare>
 	void sort(const RandomAccessRange& range, Compare comp);
+	template<class T, std::size_t N>
+	void sort(const fixed_range<T, N>& range);
+	template<class T, std::size_t N, class Compare>
+	void sort(const fixed_range<T, N>& range, Compare comp);
 
 	template<class RandomAccessRange>
 	void stable_sort(const RandomAccessRange& range);
 	template<class RandomAccessRange, class Compare>
 	void stable_sort(const RandomAccessRange& range, Compare comp);
+	template<class RandomAccessRange, class Compare, class ScratchRange>
+	void stable_sort(const RandomAccessRange& range, Compare comp, const ScratchRange& scratch);
+	template<class RandomAccessRange>
+	void stable_sort(const RandomAccessRange& range, scratch_buffer& scratch);
+	template<class RandomAccessRange, class Compare>
+	void stable_sort(const RandomAccessRange& range, Compare comp, scratch_buffer& scratch);
+
+	template<class RandomAccessRange>
+	void radix_sort(const RandomAccessRange& range);
+	template<class RandomAccessRange, class KeyFunction>
+	void radix_sort(const RandomAccessRange& range, KeyFunction key);
+	template<class RandomAccessRange>
+	void parallel_radix_sort(const RandomAccessRange& range);
+	template<class RandomAccessRange, class KeyFunction>
+	void parallel_radix_sort(const RandomAccessRange& range, KeyFunction key);
+	template<class RandomAccessRange>
+	void string_sort(const RandomAccessRange& range);
+	template<class RandomAccessRange, class KeyFunction>
+	void string_sort(const RandomAccessRange& range, KeyFunction key);
+	template<class RandomAccessRange, class KeyFunction>
+	void sort_by_key(const RandomAccessRange& range, KeyFunction key);
+	template<class RandomAccessRange, class KeyFunction, class Compare>
+	void sort_by_key(const RandomAccessRange& range, KeyFunction key, Compare comp);
+	template<class RandomAccessRange, class KeyFunction>
+	void stable_sort_by_key(const RandomAccessRange& range, KeyFunction key);
+	template<class RandomAccessRange, class KeyFunction, class Compare>
+	void stable_sort_by_key(const RandomAccessRange& range, KeyFunction key, Compare comp);
 
 	template<class RandomAccessRange>
 	void partial_sort(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type middle);
@@ -218,12 +314,22 @@ namespace stdext
 	void nth_element(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type nth);
 	template<class RandomAccessRange, class Compare>
 	void nth_element(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type nth, Compare comp);
+	template<class RandomAccessRange>
+	void parallel_partial_sort(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type middle);
+	template<class RandomAccessRange, class Compare>
+	void parallel_partial_sort(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type middle, Compare comp);
+	template<class RandomAccessRange>
+	void parallel_nth_element(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type nth);
+	template<class RandomAccessRange, class Compare>
+	void parallel_nth_element(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type nth, Compare comp);
 
 	// 25.4.3, binary search:
 	template<class ForwardRange, class T>
 	typename range_traits<ForwardRange>::position_type lower_bound(const ForwardRange& range, const T& value);
 	template<class ForwardRange, class T, class Compare>
 	typename range_traits<ForwardRange>::position_type lower_bound(const ForwardRange& range, const T& value, Compare comp);
+	template<class RandomAccessRange, class T>
+	typename range_traits<RandomAccessRange>::position_type interpolation_lower_bound(const RandomAccessRange& range, const T& value);
 	template<class ForwardRange, class T>
 	typename range_traits<ForwardRange>::position_type upper_bound(const ForwardRange& range, const T& value);
 	template<class ForwardRange, class T, class Compare>
@@ -239,6 +345,47 @@ namespace stdext
 	template<class ForwardRange, class T, class Compare>
 	bool binary_search(const ForwardRange& range, const T& value, Compare comp);
 
+	// A copy of a sorted range laid out for repeated lower_bound queries.  The elements are stored
+	// in Eytzinger (breadth-first) order, so that the first levels of every search share a few
+	// cache lines and the nodes a search may visit four levels on can be prefetched together.
+	// Each step of a search is a comparison whose result is added into the next node's index,
+	// with no branch to mispredict.  T must be default constructible.
+	template <class T, class Compare = std::less<>>
+	class search_index
+	{
+	public:
+		typedef T value_type;
+		typedef std::size_t size_type;
+
+	public:
+		search_index() : n(0), tree(1), ranks(1) { }
+		template <class ForwardRange>
+		explicit search_index(const ForwardRange& sorted, Compare comp = Compare());
+
+	public:
+		size_type size() const noexcept { return n; }
+		bool      empty() const noexcept { return n == 0; }
+
+		// The index in the source range of the first element not ordered before value, or size().
+		template <class U>
+		size_type lower_bound(const U& value) const;
+		// Writes lower_bound(v) for each value v in values through result.  Searches are run
+		// several at a time, in step, so that their memory accesses overlap.
+		template <class InputRange, class OutputIterator>
+		OutputIterator lower_bound(const InputRange& values, OutputIterator result) const;
+
+	private:
+		template <class Position, class ForwardRange>
+		void build(const ForwardRange& sorted, Position& p, size_type k, size_type& rank);
+		void prefetch(size_type k) const noexcept;
+		size_type finish(size_type k) const noexcept;
+
+		size_type n;
+		std::vector<T> tree;			// tree[k] has children tree[2k] and tree[2k + 1]; tree[0] is unused
+		std::vector<size_type> ranks;	// ranks[k] is the index of tree[k] in the source range
+		Compare comp;
+	};
+
 	// 25.4.4, merge:
 	template<class InputRange1, class InputRange2, class OutputIterator>
 	OutputIterator merge(const InputRange1& range1, const InputRange2& range2, OutputIterator result);
@@ -249,6 +396,10 @@ namespace stdext
 	void inplace_merge(const BidirectionalRange& range, typename range_traits<BidirectionalRange>::position_type middle);
 	template<class BidirectionalRange, class Compare>
 	void inplace_merge(const BidirectionalRange& range, typename range_traits<BidirectionalRange>::position_type middle, Compare comp);
+	template<class BidirectionalRange>
+	void inplace_merge(const BidirectionalRange& range, typename range_traits<BidirectionalRange>::position_type middle, scratch_buffer& scratch);
+	template<class BidirectionalRange, class Compare>
+	void inplace_merge(const BidirectionalRange& range, typename range_traits<BidirectionalRange>::position_type middle, Compare comp, scratch_buffer& scratch);
 
 	// 25.4.5, set operations:
 	template<class InputRange1, class InputRange2>
@@ -306,11 +457,86 @@ namespace stdext
 	template<class RandomAccessRange, class Compare>
 	typename range_traits<RandomAccessRange>::position_type is_heap_until(const RandomAccessRange& range, Compare comp);
 
+	// Heaps in which each element has Arity children, for any Arity of at least 2.
+	template<std::size_t Arity, class RandomAccessRange>
+	void push_dary_heap(const RandomAccessRange& range);
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	void push_dary_heap(const RandomAccessRange& range, Compare comp);
+	template<std::size_t Arity, class RandomAccessRange>
+	void pop_dary_heap(const RandomAccessRange& range);
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	void pop_dary_heap(const RandomAccessRange& range, Compare comp);
+	template<std::size_t Arity, class RandomAccessRange>
+	void make_dary_heap(const RandomAccessRange& range);
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	void make_dary_heap(const RandomAccessRange& range, Compare comp);
+	template<std::size_t Arity, class RandomAccessRange>
+	void sort_dary_heap(const RandomAccessRange& range);
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	void sort_dary_heap(const RandomAccessRange& range, Compare comp);
+	template<std::size_t Arity, class RandomAccessRange>
+	bool is_dary_heap(const RandomAccessRange& range);
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	bool is_dary_heap(const RandomAccessRange& range, Compare comp);
+
+	// A priority queue over a d-ary heap.  As with std::priority_queue, top() is the element that
+	// sorts last under Compare.
+	template <class T, std::size_t Arity = 4, class Compare = std::less<>>
+	class heap_queue
+	{
+		static_assert(Arity >= 2, "stdext::heap_queue: Arity must be at least 2");
+
+	public:
+		typedef T value_type;
+		typedef std::size_t size_type;
+		typedef iterator_range<typename std::vector<T>::const_iterator> range_type;
+
+	public:
+		heap_queue() : comp() { }
+		explicit heap_queue(Compare comp) : comp(std::move(comp)) { }
+
+	public:
+		bool      empty() const noexcept  { return values.empty(); }
+		size_type size() const noexcept   { return values.size(); }
+		const T&  top() const             { return values.front(); }
+		// The elements in heap order.
+		range_type elements() const       { return range_type(values.cbegin(), values.cend()); }
+
+		void reserve(size_type n)         { values.reserve(n); }
+		void clear() noexcept             { values.clear(); }
+
+		void push(const T& value)         { values.push_back(value); sift_up(); }
+		void push(T&& value)              { values.push_back(std::move(value)); sift_up(); }
+		template <class... Args>
+		void emplace(Args&&... args)      { values.emplace_back(std::forward<Args>(args)...); sift_up(); }
+		// Pushes every element of range, rebuilding the heap instead when that is cheaper.
+		template <class InputRange>
+		void push_range(const InputRange& range);
+
+		void pop();
+		// Moves up to n elements out through result, in the order they would be popped.
+		template <class OutputIterator>
+		OutputIterator pop_n(size_type n, OutputIterator result);
+
+	private:
+		void sift_up()
+		{
+			push_dary_heap<Arity>(make_range(values.begin(), values.end()), comp);
+		}
+
+		std::vector<T> values;
+		Compare comp;
+	};
+
 	// 25.4.7, minimum and maximum:
 	template<class ForwardRange>
 	typename range_traits<ForwardRange>::position_type min_element(const ForwardRange& range);
 	template<class ForwardRange, class Compare>
 	typename range_traits<ForwardRange>::position_type min_element(const ForwardRange& range, Compare comp);
+	template<class T, std::size_t N>
+	T* min_element(const fixed_range<T, N>& range);
+	template<class T, std::size_t N, class Compare>
+	T* min_element(const fixed_range<T, N>& range, Compare comp);
 	template<class ForwardRange>
 	typename range_traits<ForwardRange>::position_type max_element(const ForwardRange& range);
 	template<class ForwardRange, class Compare>
@@ -1,12 +1,141 @@
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <new>
 #include <random>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>	// for _mm_prefetch
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>	// for the SSE2 set_intersection kernel
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>	// for the AVX2 set_intersection kernel
+#endif
+
 namespace stdext
 {
+	namespace detail
+	{
+		// Gives back everything allocated from a scratch buffer during its lifetime.
+		class scratch_scope
+		{
+		public:
+			explicit scratch_scope(scratch_buffer& scratch) noexcept : scratch(scratch), mark(scratch.next) { }
+			scratch_scope(const scratch_scope&) = delete;
+			scratch_scope& operator = (const scratch_scope&) = delete;
+			~scratch_scope() { scratch.next = mark; }
+
+		private:
+			scratch_buffer& scratch;
+			unsigned char* mark;
+		};
+
+		// Up to the requested number of objects constructed in a scratch buffer, destroyed and
+		// given back when it goes out of scope.  Only as many objects as fit are constructed.
+		template <class T>
+		class scratch_array
+		{
+		public:
+			scratch_array(scratch_buffer& scratch, std::size_t n) : scope(scratch), first(nullptr), count(0)
+			{
+				n = std::is_default_constructible<T>::value ? std::min(n, scratch.available<T>()) : 0;
+				first = scratch.allocate<T>(n);
+				for (; first != nullptr && count != n; ++count)
+					construct(first + count, std::is_default_constructible<T>());
+			}
+			~scratch_array()
+			{
+				while (count != 0)
+					first[--count].~T();
+			}
+
+			T* data() const noexcept { return first; }
+			std::ptrdiff_t size() const noexcept { return static_cast<std::ptrdiff_t>(count); }
+
+		private:
+			static void construct(T* p, std::true_type) { ::new (static_cast<void*>(p)) T(); }
+			static void construct(T*, std::false_type) { }
+
+			scratch_scope scope;
+			T* first;
+			std::size_t count;
+		};
+
+		// Up to the requested number of objects in storage from the heap, destroyed and freed when
+		// it goes out of scope; if n objects cannot be allocated, as many as can, halving each time.
+		// The objects are move constructed from *seed along the buffer and the last one is moved
+		// back, so T need only be movable, and no default constructor runs.
+		template <class T>
+		class temporary_buffer
+		{
+		public:
+			template <class Iterator>
+			temporary_buffer(Iterator seed, std::size_t n) : first(nullptr), count(0)
+			{
+				while (n != 0 && (first = static_cast<T*>(::operator new(n * sizeof(T), std::nothrow))) == nullptr)
+					n /= 2;
+				if (first == nullptr)
+					return;
+
+				try
+				{
+					::new (static_cast<void*>(first)) T(std::move(*seed));
+					for (count = 1; count != n; ++count)
+						::new (static_cast<void*>(first + count)) T(std::move(first[count - 1]));
+					*seed = std::move(first[count - 1]);
+				}
+				catch (...)
+				{
+					release();
+					throw;
+				}
+			}
+			temporary_buffer(const temporary_buffer&) = delete;
+			temporary_buffer& operator = (const temporary_buffer&) = delete;
+			~temporary_buffer() { release(); }
+
+			T* data() const noexcept { return first; }
+			std::ptrdiff_t size() const noexcept { return static_cast<std::ptrdiff_t>(count); }
+
+		private:
+			void release() noexcept
+			{
+				while (count != 0)
+					first[--count].~T();
+				::operator delete(first);
+			}
+
+			T* first;
+			std::size_t count;
+		};
+
+		// Algorithms over a fixed_range expand into straight-line code up to this extent, past
+		// which the expansion would cost more in code size than it saves in loop overhead.
+		const std::size_t fixed_unroll_limit = 64;
+
+		template <std::size_t N, std::size_t Limit = fixed_unroll_limit>
+		struct is_fixed_unrolled : std::integral_constant<bool, 0 < N && N <= Limit>
+		{
+		};
+
+		// Whether a fixed_range still spans its whole array.
+		template <class T, std::size_t N>
+		bool is_full(const fixed_range<T, N>& range)
+		{
+			return range.end_pos() - range.begin_pos() == static_cast<std::ptrdiff_t>(N);
+		}
+	}
+
 	// 25.2, non-modifying sequence operations:
 	template <class InputRange, class Predicate>
 	bool all_of(const InputRange& range, Predicate pred)
@@ -208,6 +337,44 @@ namespace stdext
 			&& positions.second == range2.end_pos();
 	}
 
+	namespace detail
+	{
+		template<class T, class U, class BinaryPredicate, std::size_t... I>
+		bool unrolled_equal(T* first1, U* first2, BinaryPredicate pred, std::index_sequence<I...>)
+		{
+			bool result = true;
+			int expand[] = { 0, (result = result && pred(first1[I], first2[I]), 0)... };
+			(void)expand;
+			return result;
+		}
+
+		template<class T, class U, std::size_t N, class BinaryPredicate>
+		bool equal(const fixed_range<T, N>& range1, const fixed_range<U, N>& range2, BinaryPredicate pred, std::false_type /* is_fixed_unrolled */)
+		{
+			return stdext::equal(static_cast<const iterator_range<T*>&>(range1), static_cast<const iterator_range<U*>&>(range2), pred);
+		}
+
+		template<class T, class U, std::size_t N, class BinaryPredicate>
+		bool equal(const fixed_range<T, N>& range1, const fixed_range<U, N>& range2, BinaryPredicate pred, std::true_type /* is_fixed_unrolled */)
+		{
+			if (!is_full(range1) || !is_full(range2))
+				return detail::equal(range1, range2, pred, std::false_type());
+			return unrolled_equal(range1.begin_pos(), range2.begin_pos(), pred, std::make_index_sequence<N>());
+		}
+	}
+
+	template<class T, class U, std::size_t N>
+	bool equal(const fixed_range<T, N>& range1, const fixed_range<U, N>& range2)
+	{
+		return detail::equal(range1, range2, ::std::equal_to<>(), detail::is_fixed_unrolled<N>());
+	}
+
+	template<class T, class U, std::size_t N, class BinaryPredicate>
+	bool equal(const fixed_range<T, N>& range1, const fixed_range<U, N>& range2, BinaryPredicate pred)
+	{
+		return detail::equal(range1, range2, pred, detail::is_fixed_unrolled<N>());
+	}
+
 	template<class ForwardRange1, class ForwardIterator2>
 	typename std::enable_if<!is_range<ForwardIterator2>::value, bool>::type
 		is_permutation(const ForwardRange1& range1, ForwardIterator2 first2)
@@ -230,7 +397,7 @@ namespace stdext
 	typename std::enable_if<is_range<ForwardRange2>::value, bool>::type
 		is_permutation(const ForwardRange1& range1, const ForwardRange2& range2)
 	{
-		return is_permutation(range1, range2, ::std::equal_to<>());
+		return stdext::is_permutation(range1, range2, ::std::equal_to<>());
 	}
 
 	template<class ForwardRange1, class ForwardRange2, class BinaryPredicate>
@@ -246,6 +413,339 @@ namespace stdext
 								   pred);
 	}
 
+	namespace detail
+	{
+		// The positions of a range, copied into a scratch buffer if they fit.
+		template <class Range>
+		class scratch_positions
+		{
+		public:
+			typedef typename range_traits<Range>::position_type position_type;
+
+		public:
+			scratch_positions(const Range& range, std::size_t n, scratch_buffer& scratch) : first(scratch.allocate<position_type>(n)), count(0)
+			{
+				if (first == nullptr)
+					return;
+				for (auto p = range.begin_pos(), last = range.end_pos(); p != last; range.increment_pos(p))
+					::new (static_cast<void*>(first + count++)) position_type(p);
+			}
+			scratch_positions(const scratch_positions&) = delete;
+			scratch_positions& operator = (const scratch_positions&) = delete;
+			~scratch_positions()
+			{
+				while (count != 0)
+					first[--count].~position_type();
+			}
+
+			position_type* begin() const noexcept { return first; }
+			position_type* end() const noexcept { return first + count; }
+			explicit operator bool () const noexcept { return first != nullptr; }
+
+		private:
+			position_type* first;
+			std::size_t count;
+		};
+	}
+
+	namespace detail
+	{
+		// Spreads the bits of a hash over the whole word.  std::hash of an integer is often the
+		// integer itself, which would crowd keys such as multiples of 1024 into a few slots.  The
+		// multiplication carries every bit of the hash into the high half, which is folded back
+		// into the low bits that pick the slot.
+		inline std::uint64_t mix_hash(std::size_t hash) noexcept
+		{
+			std::uint64_t x = hash * 0x9e3779b97f4a7c15ull;
+			return x ^ (x >> 32);
+		}
+
+		// The slots of an open-addressing hash table with linear probing.  Each slot has a tag byte
+		// holding seven bits of the hash of its value, or zero while it is empty, so that most
+		// probes compare a byte rather than a value.  The slots come from a scratch buffer while it
+		// has room, and otherwise from the heap if use_heap allows it.
+		template <class T>
+		class hash_slots
+		{
+		public:
+			hash_slots() noexcept : values(nullptr), tags(nullptr), mask(0), count(0), heap(false) { }
+			hash_slots(std::size_t capacity, scratch_buffer* scratch, bool use_heap) : hash_slots()
+			{
+				if (scratch != nullptr && (values = scratch->allocate<T>(capacity)) != nullptr)
+					tags = scratch->allocate<unsigned char>(capacity);
+				if (tags == nullptr && use_heap)
+				{
+					values = static_cast<T*>(::operator new(capacity * (sizeof(T) + 1)));
+					tags = reinterpret_cast<unsigned char*>(values + capacity);
+					heap = true;
+				}
+				if (tags != nullptr)
+				{
+					std::memset(tags, 0, capacity);
+					mask = capacity - 1;
+				}
+			}
+			hash_slots(const hash_slots&) = delete;
+			hash_slots& operator = (const hash_slots&) = delete;
+			~hash_slots()
+			{
+				for (std::size_t i = 0; i != capacity(); ++i)
+				{
+					if (tags[i] != 0)
+						values[i].~T();
+				}
+				if (heap)
+					::operator delete(values);
+			}
+
+			explicit operator bool () const noexcept { return tags != nullptr; }
+			std::size_t size() const noexcept { return count; }
+			std::size_t capacity() const noexcept { return tags != nullptr ? mask + 1 : 0; }
+
+			// Whether one more value would load the table past three quarters of its capacity.
+			bool full() const noexcept { return 4 * (count + 1) > 3 * capacity(); }
+
+			// Returns the slot holding a value that matches, or else the empty slot where it belongs.
+			template <class Match>
+			std::size_t find(std::size_t hash, Match match) const
+			{
+				auto mixed = mix_hash(hash);
+				auto tag = static_cast<unsigned char>(0x80 | (mixed >> 57));
+				for (auto i = static_cast<std::size_t>(mixed) & mask; ; i = (i + 1) & mask)
+				{
+					if (tags[i] == 0 || (tags[i] == tag && match(values[i])))
+						return i;
+				}
+			}
+
+			bool occupied(std::size_t i) const noexcept { return tags[i] != 0; }
+			T& operator [] (std::size_t i) const noexcept { return values[i]; }
+
+			// Constructs a value in the empty slot i returned by find.
+			template <class... Args>
+			T& emplace(std::size_t i, std::size_t hash, Args&&... args)
+			{
+				::new (static_cast<void*>(values + i)) T(std::forward<Args>(args)...);
+				tags[i] = static_cast<unsigned char>(0x80 | (mix_hash(hash) >> 57));
+				++count;
+				return values[i];
+			}
+
+			// Moves the values into new slots of the given capacity, rehashing them with hash_of.
+			template <class HashOf>
+			bool rehash(std::size_t capacity, HashOf& hash_of, scratch_buffer* scratch, bool use_heap)
+			{
+				hash_slots slots(capacity, scratch, use_heap);
+				if (!slots)
+					return false;
+				for (std::size_t i = 0; i != this->capacity(); ++i)
+				{
+					if (tags[i] != 0)
+					{
+						auto hash = hash_of(values[i]);
+						slots.emplace(slots.find(hash, [](const T&) { return false; }), hash, std::move(values[i]));
+					}
+				}
+				swap(slots);
+				return true;
+			}
+
+			void swap(hash_slots& other) noexcept
+			{
+				std::swap(values, other.values);
+				std::swap(tags, other.tags);
+				std::swap(mask, other.mask);
+				std::swap(count, other.count);
+				std::swap(heap, other.heap);
+			}
+
+		private:
+			T* values;
+			unsigned char* tags;
+			std::size_t mask;
+			std::size_t count;
+			bool heap;
+		};
+
+		// The smallest power of two capacity that holds n values within the maximum load.
+		inline std::size_t hash_capacity(std::size_t n) noexcept
+		{
+			std::size_t capacity = 8;
+			while (3 * capacity < 4 * n)
+				capacity *= 2;
+			return capacity;
+		}
+
+		// Value types that std::hash supports, so that hashing finds the same permutations as
+		// comparing with ==.  Equal values hash alike, so 0.0 and -0.0 are counted together, and
+		// NaN, equal to nothing, matches nothing.
+		template <class T>
+		struct is_exact_hashable : std::integral_constant<bool,
+			std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value>
+		{
+		};
+		template <class CharT>
+		struct is_exact_hashable<std::basic_string<CharT>> : std::true_type
+		{
+		};
+
+		// An element of range1 and how many of its equals in range1 are not yet matched in range2.
+		template <class Position>
+		struct permutation_count
+		{
+			Position pos;
+			std::size_t count;
+		};
+
+		template<class ForwardRange1, class ForwardRange2, class Hash, class KeyEqual>
+		bool hashed_is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, Hash& hash, KeyEqual& eq,
+			hash_slots<permutation_count<typename range_traits<ForwardRange1>::position_type>>& slots)
+		{
+			typedef permutation_count<typename range_traits<ForwardRange1>::position_type> counted;
+			for (auto p = range1.begin_pos(), last = range1.end_pos(); p != last; range1.increment_pos(p))
+			{
+				auto&& value = range1.at_pos(p);
+				auto h = hash(value);
+				auto i = slots.find(h, [&](const counted& c) { return eq(range1.at_pos(c.pos), value); });
+				if (slots.occupied(i))
+					++slots[i].count;
+				else
+					slots.emplace(i, h, counted { p, 1 });
+			}
+			for (auto p = range2.begin_pos(), last = range2.end_pos(); p != last; range2.increment_pos(p))
+			{
+				auto&& value = range2.at_pos(p);
+				auto i = slots.find(hash(value), [&](const counted& c) { return eq(range1.at_pos(c.pos), value); });
+				if (!slots.occupied(i) || slots[i].count == 0)
+					return false;
+				--slots[i].count;
+			}
+			return true;
+		}
+
+		// Value types for which sorting by < finds the same permutations as comparing with ==:
+		// those with an operator <, which must order them strictly and weakly, with equivalence
+		// meaning equality.  Floating point values are not, because of NaN.
+		template <class T, class Enable = void>
+		struct is_less_comparable : std::false_type
+		{
+		};
+
+		template <class T>
+		struct is_less_comparable<T, decltype((void)(std::declval<const T&>() < std::declval<const T&>()))>
+			: std::integral_constant<bool, !std::is_floating_point<T>::value>
+		{
+		};
+
+		template<class ForwardRange1, class ForwardRange2>
+		bool ordered_is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, scratch_buffer& scratch, std::true_type /* is_less_comparable */)
+		{
+			return stdext::is_permutation(range1, range2, std::less<>(), scratch);
+		}
+
+		template<class ForwardRange1, class ForwardRange2>
+		bool ordered_is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, scratch_buffer&, std::false_type /* is_less_comparable */)
+		{
+			return stdext::is_permutation(range1, range2);
+		}
+
+		template<class ForwardRange1, class ForwardRange2>
+		bool is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, scratch_buffer& scratch, std::false_type /* is_exact_hashable */)
+		{
+			return ordered_is_permutation(range1, range2, scratch,
+				is_less_comparable<typename std::remove_cv<typename range_traits<ForwardRange1>::value_type>::type>());
+		}
+
+		template<class ForwardRange1, class ForwardRange2>
+		bool is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, scratch_buffer& scratch, std::true_type /* is_exact_hashable */)
+		{
+			auto n = length(range1);
+			if (n != length(range2))
+				return false;
+
+			{
+				scratch_scope scope(scratch);
+				hash_slots<permutation_count<typename range_traits<ForwardRange1>::position_type>> slots(hash_capacity(static_cast<std::size_t>(n)), &scratch, false);
+				std::hash<typename std::remove_cv<typename range_traits<ForwardRange1>::value_type>::type> hash;
+				std::equal_to<> eq;
+				if (slots)
+					return hashed_is_permutation(range1, range2, hash, eq, slots);
+			}
+			return ordered_is_permutation(range1, range2, scratch,
+				is_less_comparable<typename std::remove_cv<typename range_traits<ForwardRange1>::value_type>::type>());
+		}
+	}
+
+	// Finds the same answer as the overload without scratch, which compares elements with ==.
+	// Arithmetic values, enumerations, pointers and strings are counted in a hash table, in O(n)
+	// expected time, if it fits in the scratch buffer.  Other elements, and those for which it
+	// does not fit, are compared by sorting if they have an operator <, whose equivalence must then
+	// be equality, and otherwise by the quadratic comparison.
+	template<class ForwardRange1, class ForwardRange2>
+	bool is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, scratch_buffer& scratch)
+	{
+		return detail::is_permutation(range1, range2, scratch,
+			detail::is_exact_hashable<typename std::remove_cv<typename range_traits<ForwardRange1>::value_type>::type>());
+	}
+
+	// Decides whether the ranges are permutations of one another by sorting the positions of each
+	// by comp, a strict weak ordering, in O(n log n).  Elements are permutations if they are
+	// equivalent under comp.  If the positions do not fit in the scratch buffer, falls back to the
+	// quadratic comparison using equivalence.
+	template<class ForwardRange1, class ForwardRange2, class Compare>
+	bool is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, Compare comp, scratch_buffer& scratch)
+	{
+		auto n = length(range1);
+		if (n != length(range2))
+			return false;
+
+		detail::scratch_scope scope(scratch);
+		detail::scratch_positions<ForwardRange1> positions1(range1, static_cast<std::size_t>(n), scratch);
+		detail::scratch_positions<ForwardRange2> positions2(range2, static_cast<std::size_t>(n), scratch);
+		if (!positions1 || !positions2)
+		{
+			return std::is_permutation(range_iterator<ForwardRange1>(range1, range1.begin_pos()),
+									   range_iterator<ForwardRange1>(range1, range1.end_pos()),
+									   range_iterator<ForwardRange2>(range2, range2.begin_pos()),
+									   [&](const auto& a, const auto& b) { return !comp(a, b) && !comp(b, a); });
+		}
+
+		typedef typename range_traits<ForwardRange1>::position_type position1;
+		typedef typename range_traits<ForwardRange2>::position_type position2;
+		std::sort(positions1.begin(), positions1.end(), [&](const position1& a, const position1& b) { return comp(range1.at_pos(a), range1.at_pos(b)); });
+		std::sort(positions2.begin(), positions2.end(), [&](const position2& a, const position2& b) { return comp(range2.at_pos(a), range2.at_pos(b)); });
+		for (auto p1 = positions1.begin(), p2 = positions2.begin(); p1 != positions1.end(); ++p1, ++p2)
+		{
+			if (comp(range1.at_pos(*p1), range2.at_pos(*p2)) || comp(range2.at_pos(*p2), range1.at_pos(*p1)))
+				return false;
+		}
+		return true;
+	}
+
+	// Decides whether the ranges are permutations of one another in O(n) expected time, by counting
+	// the elements of range1 in a hash table and checking those of range2 off against the counts.
+	// Elements are permutations if they are equal under eq, and elements that are equal must have
+	// equal hashes.  If the table does not fit in the scratch buffer, falls back to the quadratic
+	// comparison.
+	template<class ForwardRange1, class ForwardRange2, class Hash, class KeyEqual>
+	bool is_permutation(const ForwardRange1& range1, const ForwardRange2& range2, Hash hash, KeyEqual eq, scratch_buffer& scratch)
+	{
+		auto n = length(range1);
+		if (n != length(range2))
+			return false;
+
+		{
+			detail::scratch_scope scope(scratch);
+			detail::hash_slots<detail::permutation_count<typename range_traits<ForwardRange1>::position_type>> slots(detail::hash_capacity(static_cast<std::size_t>(n)), &scratch, false);
+			if (slots)
+				return detail::hashed_is_permutation(range1, range2, hash, eq, slots);
+		}
+		return std::is_permutation(range_iterator<ForwardRange1>(range1, range1.begin_pos()),
+								   range_iterator<ForwardRange1>(range1, range1.end_pos()),
+								   range_iterator<ForwardRange2>(range2, range2.begin_pos()),
+								   eq);
+	}
+
 	template<class ForwardRange1, class ForwardRange2>
 	typename range_traits<ForwardRange1>::position_type search(const ForwardRange1& range1, const ForwardRange2& range2)
 	{
@@ -392,6 +892,37 @@ namespace stdext
 				  value);
 	}
 
+	namespace detail
+	{
+		template<class T, class U, std::size_t... I>
+		void unrolled_fill(T* first, const U& value, std::index_sequence<I...>)
+		{
+			int expand[] = { 0, (first[I] = value, 0)... };
+			(void)expand;
+		}
+
+		template<class T, std::size_t N, class U>
+		void fill(const fixed_range<T, N>& range, const U& value, std::false_type /* is_fixed_unrolled */)
+		{
+			std::fill(range.begin_pos(), range.end_pos(), value);
+		}
+
+		template<class T, std::size_t N, class U>
+		void fill(const fixed_range<T, N>& range, const U& value, std::true_type /* is_fixed_unrolled */)
+		{
+			if (!is_full(range))
+				detail::fill(range, value, std::false_type());
+			else
+				unrolled_fill(range.begin_pos(), value, std::make_index_sequence<N>());
+		}
+	}
+
+	template<class T, std::size_t N, class U>
+	void fill(const fixed_range<T, N>& range, const U& value)
+	{
+		detail::fill(range, value, detail::is_fixed_unrolled<N>());
+	}
+
 	template<class OutputRange, class Size, class T>
 	OutputRange fill_n(OutputRange range, Size n, const T& value)
 	{
@@ -556,6 +1087,54 @@ namespace stdext
 									 pred).pos();
 	}
 
+	namespace detail
+	{
+		// Partitions [first, last) of length n stably.  If it fits in the buffer, the elements
+		// that fail the predicate are set aside there while the others are compacted; otherwise
+		// both halves are partitioned recursively and the middle sections rotated into place.
+		template <class Iterator, class BufferIterator, class Predicate>
+		Iterator stable_partition_adaptive(Iterator first, Iterator last, std::ptrdiff_t n, BufferIterator buffer, std::ptrdiff_t buffer_size, Predicate pred)
+		{
+			if (n == 0)
+				return first;
+			if (n == 1)
+				return pred(*first) ? last : first;
+
+			if (n <= buffer_size)
+			{
+				auto out = first;
+				auto b = buffer;
+				for (; first != last; ++first)
+				{
+					if (pred(*first))
+						*out++ = std::move(*first);
+					else
+						*b++ = std::move(*first);
+				}
+				std::move(buffer, b, out);
+				return out;
+			}
+
+			auto middle = std::next(first, n / 2);
+			auto left = stable_partition_adaptive(first, middle, n / 2, buffer, buffer_size, pred);
+			auto right = stable_partition_adaptive(middle, last, n - n / 2, buffer, buffer_size, pred);
+			return std::rotate(left, middle, right);
+		}
+	}
+
+	// As above, setting aside elements in the scratch buffer, or with O(n log n) rotations for the
+	// parts of the range that do not fit.
+	template<class BidirectionalRange, class Predicate>
+	typename range_traits<BidirectionalRange>::position_type stable_partition(const BidirectionalRange& range, Predicate pred, scratch_buffer& scratch)
+	{
+		typedef typename std::remove_cv<typename range_traits<BidirectionalRange>::value_type>::type value_type;
+		auto n = length(range);
+		detail::scratch_array<value_type> buffer(scratch, static_cast<std::size_t>(n));
+		return detail::stable_partition_adaptive(range_iterator<BidirectionalRange>(range, range.begin_pos()),
+												 range_iterator<BidirectionalRange>(range, range.end_pos()),
+												 n, buffer.data(), buffer.size(), pred).pos();
+	}
+
 	template <class InputRange, class OutputIterator1, class OutputIterator2, class Predicate>
 	std::pair<OutputIterator1, OutputIterator2>
 		partition_copy(const InputRange& range, OutputIterator1 out_true, OutputIterator2 out_false, Predicate pred)
@@ -573,60 +1152,1329 @@ namespace stdext
 									pred).pos();
 	}
 
+	namespace detail
+	{
+		// Pattern-defeating quicksort (Orson Peters).  Introsort with median-of-3 or ninther
+		// pivots, where a partition that moved nothing triggers a bounded insertion sort so that
+		// sorted stretches finish in linear time, unbalanced partitions shuffle their elements to
+		// break adversarial patterns, and too many of them fall back to heapsort.  Cheap
+		// comparisons of arithmetic values use a partition that records out-of-place elements in
+		// blocks of offsets without branching on the comparison result.
+		const std::ptrdiff_t pdq_insertion_sort_threshold = 24;
+		const std::ptrdiff_t pdq_ninther_threshold = 128;
+		const std::ptrdiff_t pdq_partial_insertion_sort_limit = 8;
+		const std::ptrdiff_t pdq_block_size = 64;
+
+		template <class Compare, class T>
+		struct is_branchless_compare : std::integral_constant<bool,
+			std::is_arithmetic<T>::value && (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<T>>::value
+				|| std::is_same<Compare, std::greater<>>::value || std::is_same<Compare, std::greater<T>>::value)>
+		{
+		};
+
+		inline int pdq_log2(std::size_t n)
+		{
+			int log = 0;
+			while (n >>= 1)
+				++log;
+			return log;
+		}
+
+		template <class Iterator, class Compare>
+		void insertion_sort(Iterator first, Iterator last, Compare comp)
+		{
+			if (first == last)
+				return;
+			for (auto i = first + 1; i != last; ++i)
+			{
+				auto sift = i, sift_1 = i - 1;
+				if (comp(*sift, *sift_1))
+				{
+					typename std::iterator_traits<Iterator>::value_type value = std::move(*sift);
+					do *sift-- = std::move(*sift_1);
+					while (sift != first && comp(value, *--sift_1));
+					*sift = std::move(value);
+				}
+			}
+		}
+
+		// As insertion_sort, for a range that has an element not greater than any of its own
+		// immediately before it.
+		template <class Iterator, class Compare>
+		void unguarded_insertion_sort(Iterator first, Iterator last, Compare comp)
+		{
+			if (first == last)
+				return;
+			for (auto i = first + 1; i != last; ++i)
+			{
+				auto sift = i, sift_1 = i - 1;
+				if (comp(*sift, *sift_1))
+				{
+					typename std::iterator_traits<Iterator>::value_type value = std::move(*sift);
+					do *sift-- = std::move(*sift_1);
+					while (comp(value, *--sift_1));
+					*sift = std::move(value);
+				}
+			}
+		}
+
+		// Attempts an insertion sort, giving up once more than a few elements have had to move.
+		template <class Iterator, class Compare>
+		bool partial_insertion_sort(Iterator first, Iterator last, Compare comp)
+		{
+			if (first == last)
+				return true;
+			std::ptrdiff_t moved = 0;
+			for (auto i = first + 1; i != last; ++i)
+			{
+				auto sift = i, sift_1 = i - 1;
+				if (comp(*sift, *sift_1))
+				{
+					typename std::iterator_traits<Iterator>::value_type value = std::move(*sift);
+					do *sift-- = std::move(*sift_1);
+					while (sift != first && comp(value, *--sift_1));
+					*sift = std::move(value);
+					moved += i - sift;
+				}
+				if (moved > pdq_partial_insertion_sort_limit)
+					return false;
+			}
+			return true;
+		}
+
+		template <class Iterator, class Compare>
+		void sort2(Iterator a, Iterator b, Compare comp)
+		{
+			if (comp(*b, *a))
+				std::iter_swap(a, b);
+		}
+
+		template <class Iterator, class Compare>
+		void sort3(Iterator a, Iterator b, Iterator c, Compare comp)
+		{
+			sort2(a, b, comp);
+			sort2(b, c, comp);
+			sort2(a, b, comp);
+		}
+
+		// Sorting networks.  Below this length a cheap comparison sorts faster through a fixed
+		// sequence of compare-exchanges, none of which branches on the data, than through an
+		// insertion sort whose every step is a mispredictable branch.
+		const std::ptrdiff_t sort_network_limit = 32;
+
+		template <class Iterator, class Compare>
+		void compare_exchange(Iterator a, Iterator b, Compare comp, std::false_type /* is_branchless_compare */)
+		{
+			sort2(a, b, comp);
+		}
+
+		template <class Iterator, class Compare>
+		void compare_exchange(Iterator a, Iterator b, Compare comp, std::true_type /* is_branchless_compare */)
+		{
+			auto x = *a, y = *b;
+			bool swap = comp(y, x);
+			*a = swap ? y : x;
+			*b = swap ? x : y;
+		}
+
+		// Batcher's merge-exchange network (Knuth, TAOCP 5.2.2, Algorithm M), which sorts any
+		// length with O(n log^2 n) comparators.  Visits each comparator (lo, hi) in order.
+		template <class Visitor>
+		constexpr void merge_exchange_network(std::size_t n, Visitor& visit)
+		{
+			if (n < 2)
+				return;
+			std::size_t t = 1;
+			while ((std::size_t(1) << t) < n)
+				++t;
+			for (std::size_t p = std::size_t(1) << (t - 1); p > 0; p >>= 1)
+			{
+				std::size_t q = std::size_t(1) << (t - 1), r = 0, d = p;
+				for (;;)
+				{
+					for (std::size_t i = 0; i + d < n; ++i)
+					{
+						if ((i & p) == r)
+							visit(i, i + d);
+					}
+					if (q == p)
+						break;
+					d = q - p;
+					q >>= 1;
+					r = p;
+				}
+			}
+		}
+
+		template <class Iterator, class Compare, class Branchless>
+		struct network_exchanger
+		{
+			Iterator first;
+			Compare comp;
+
+			void operator ()(std::size_t lo, std::size_t hi)
+			{
+				compare_exchange(first + lo, first + hi, comp, Branchless());
+			}
+		};
+
+		template <class Iterator, class Compare, class Branchless>
+		void network_sort(Iterator first, Iterator last, Compare comp, Branchless)
+		{
+			network_exchanger<Iterator, Compare, Branchless> exchange = { first, comp };
+			merge_exchange_network(static_cast<std::size_t>(last - first), exchange);
+		}
+
+		// The same network for a length known at compile time, as a table of comparators that
+		// fixed_range algorithms expand into straight-line code.
+		struct network_counter
+		{
+			std::size_t size;
+
+			constexpr void operator ()(std::size_t, std::size_t)
+			{
+				++size;
+			}
+		};
+
+		constexpr std::size_t merge_exchange_size(std::size_t n)
+		{
+			network_counter counter = { 0 };
+			merge_exchange_network(n, counter);
+			return counter.size;
+		}
+
+		template <std::size_t Size>
+		struct network_table
+		{
+			std::size_t lo[Size + 1], hi[Size + 1];
+			std::size_t count;
+
+			constexpr void operator ()(std::size_t l, std::size_t h)
+			{
+				lo[count] = l;
+				hi[count] = h;
+				++count;
+			}
+		};
+
+		template <std::size_t N>
+		constexpr network_table<merge_exchange_size(N)> make_sorting_network()
+		{
+			network_table<merge_exchange_size(N)> table = { { 0 }, { 0 }, 0 };
+			merge_exchange_network(N, table);
+			return table;
+		}
+
+		template <std::size_t N>
+		struct sorting_network
+		{
+			static constexpr network_table<merge_exchange_size(N)> comparators = make_sorting_network<N>();
+		};
+
+		template <std::size_t N>
+		constexpr network_table<merge_exchange_size(N)> sorting_network<N>::comparators;
+
+		template <std::size_t N, class Iterator, class Compare, class Branchless, std::size_t... I>
+		void unrolled_network_sort(Iterator first, Compare comp, Branchless, std::index_sequence<I...>)
+		{
+			int expand[] = { 0, (compare_exchange(first + sorting_network<N>::comparators.lo[I],
+												  first + sorting_network<N>::comparators.hi[I],
+												  comp, Branchless()), 0)... };
+			(void)expand;
+		}
+
+		template <class Iterator>
+		void swap_offsets(Iterator first, Iterator last, const unsigned char* offsets_l, const unsigned char* offsets_r, std::size_t n, bool use_swaps)
+		{
+			if (use_swaps)
+			{
+				// Exactly as many elements belong on each side, so each must be swapped anyway.
+				for (std::size_t i = 0; i != n; ++i)
+					std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+			}
+			else if (n != 0)
+			{
+				// Otherwise a single cyclic rotation saves a move per element.
+				auto l = first + offsets_l[0], r = last - offsets_r[0];
+				typename std::iterator_traits<Iterator>::value_type value = std::move(*l);
+				*l = std::move(*r);
+				for (std::size_t i = 1; i != n; ++i)
+				{
+					l = first + offsets_l[i];
+					*r = std::move(*l);
+					r = last - offsets_r[i];
+					*l = std::move(*r);
+				}
+				*r = std::move(value);
+			}
+		}
+
+		// Partitions [first, last) around *first, with elements equal to the pivot going right.
+		// Returns the pivot's final position and whether the range was already partitioned.
+		template <class Iterator, class Compare>
+		std::pair<Iterator, bool> partition_right(Iterator first, Iterator last, Compare comp, std::false_type /* branchless */)
+		{
+			typename std::iterator_traits<Iterator>::value_type pivot = std::move(*first);
+			auto i = first, j = last;
+			while (comp(*++i, pivot));
+			if (i - 1 == first)
+				while (i < j && !comp(*--j, pivot));
+			else
+				while (!comp(*--j, pivot));
+
+			bool already_partitioned = i >= j;
+			while (i < j)
+			{
+				std::iter_swap(i, j);
+				while (comp(*++i, pivot));
+				while (!comp(*--j, pivot));
+			}
+
+			auto pivot_pos = i - 1;
+			*first = std::move(*pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return { pivot_pos, already_partitioned };
+		}
+
+		template <class Iterator, class Compare>
+		std::pair<Iterator, bool> partition_right(Iterator first, Iterator last, Compare comp, std::true_type /* branchless */)
+		{
+			typename std::iterator_traits<Iterator>::value_type pivot = std::move(*first);
+			auto i = first, j = last;
+			while (comp(*++i, pivot));
+			if (i - 1 == first)
+				while (i < j && !comp(*--j, pivot));
+			else
+				while (!comp(*--j, pivot));
+
+			bool already_partitioned = i >= j;
+			if (!already_partitioned)
+			{
+				std::iter_swap(i, j);
+				++i;
+
+				unsigned char offsets_l[pdq_block_size], offsets_r[pdq_block_size];
+				auto base_l = i, base_r = j;
+				std::size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+				while (i < j)
+				{
+					// Fill whichever offset buffers are empty with the positions of elements on the
+					// wrong side, splitting the remaining elements between them if both are.
+					std::size_t unknown = j - i;
+					auto left_split = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+					auto right_split = num_r == 0 ? unknown - left_split : 0;
+
+					if (left_split > static_cast<std::size_t>(pdq_block_size))
+						left_split = pdq_block_size;
+					for (std::size_t k = 0; k < left_split; ++k)
+					{
+						offsets_l[num_l] = static_cast<unsigned char>(k);
+						num_l += !comp(*i, pivot);
+						++i;
+					}
+					if (right_split > static_cast<std::size_t>(pdq_block_size))
+						right_split = pdq_block_size;
+					for (std::size_t k = 0; k < right_split; )
+					{
+						offsets_r[num_r] = static_cast<unsigned char>(++k);
+						num_r += comp(*--j, pivot);
+					}
+
+					auto n = std::min(num_l, num_r);
+					swap_offsets(base_l, base_r, offsets_l + start_l, offsets_r + start_r, n, num_l == num_r);
+					num_l -= n;
+					num_r -= n;
+					start_l += n;
+					start_r += n;
+					if (num_l == 0)
+					{
+						start_l = 0;
+						base_l = i;
+					}
+					if (num_r == 0)
+					{
+						start_r = 0;
+						base_r = j;
+					}
+				}
+
+				// One buffer may still hold elements; move them next to the boundary.
+				if (num_l != 0)
+				{
+					while (num_l--)
+						std::iter_swap(base_l + offsets_l[start_l + num_l], --j);
+					i = j;
+				}
+				if (num_r != 0)
+				{
+					while (num_r--)
+						std::iter_swap(base_r - offsets_r[start_r + num_r], i), ++i;
+					j = i;
+				}
+			}
+
+			auto pivot_pos = i - 1;
+			*first = std::move(*pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return { pivot_pos, already_partitioned };
+		}
+
+		// Partitions [first, last) around *first, with elements equal to the pivot going left.
+		// Used when the pivot equals the element before the range, so that runs of equal elements
+		// are put in place in a single pass.
+		template <class Iterator, class Compare>
+		Iterator partition_left(Iterator first, Iterator last, Compare comp)
+		{
+			typename std::iterator_traits<Iterator>::value_type pivot = std::move(*first);
+			auto i = first, j = last;
+			while (comp(pivot, *--j));
+			if (j + 1 == last)
+				while (i < j && !comp(pivot, *++i));
+			else
+				while (!comp(pivot, *++i));
+
+			while (i < j)
+			{
+				std::iter_swap(i, j);
+				while (comp(pivot, *--j));
+				while (!comp(pivot, *++i));
+			}
+
+			*first = std::move(*j);
+			*j = std::move(pivot);
+			return j;
+		}
+
+		template <class Iterator, class Compare>
+		void small_sort(Iterator first, Iterator last, Compare comp, bool leftmost, std::false_type /* is_branchless_compare */)
+		{
+			if (leftmost)
+				insertion_sort(first, last, comp);
+			else
+				unguarded_insertion_sort(first, last, comp);
+		}
+
+		template <class Iterator, class Compare>
+		void small_sort(Iterator first, Iterator last, Compare comp, bool, std::true_type /* is_branchless_compare */)
+		{
+			network_sort(first, last, comp, std::true_type());
+		}
+
+		template <class Iterator, class Compare, class Branchless>
+		void pdqsort_loop(Iterator first, Iterator last, Compare comp, int bad_allowed, bool leftmost, Branchless branchless)
+		{
+			for (;;)
+			{
+				auto size = last - first;
+				if (size < pdq_insertion_sort_threshold)
+				{
+					small_sort(first, last, comp, leftmost, branchless);
+					return;
+				}
+
+				auto half = size / 2;
+				if (size > pdq_ninther_threshold)
+				{
+					sort3(first, first + half, last - 1, comp);
+					sort3(first + 1, first + (half - 1), last - 2, comp);
+					sort3(first + 2, first + (half + 1), last - 3, comp);
+					sort3(first + (half - 1), first + half, first + (half + 1), comp);
+					std::iter_swap(first, first + half);
+				}
+				else
+					sort3(first + half, first, last - 1, comp);
+
+				if (!leftmost && !comp(*(first - 1), *first))
+				{
+					first = partition_left(first, last, comp) + 1;
+					continue;
+				}
+
+				auto result = partition_right(first, last, comp, branchless);
+				auto pivot_pos = result.first;
+				auto l_size = pivot_pos - first, r_size = last - (pivot_pos + 1);
+				if (l_size < size / 8 || r_size < size / 8)
+				{
+					if (--bad_allowed == 0)
+					{
+						std::make_heap(first, last, comp);
+						std::sort_heap(first, last, comp);
+						return;
+					}
+
+					if (l_size >= pdq_insertion_sort_threshold)
+					{
+						std::iter_swap(first, first + l_size / 4);
+						std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+						if (l_size > pdq_ninther_threshold)
+						{
+							std::iter_swap(first + 1, first + (l_size / 4 + 1));
+							std::iter_swap(first + 2, first + (l_size / 4 + 2));
+							std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+							std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+						}
+					}
+					if (r_size >= pdq_insertion_sort_threshold)
+					{
+						std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+						std::iter_swap(last - 1, last - r_size / 4);
+						if (r_size > pdq_ninther_threshold)
+						{
+							std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+							std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+							std::iter_swap(last - 2, last - (1 + r_size / 4));
+							std::iter_swap(last - 3, last - (2 + r_size / 4));
+						}
+					}
+				}
+				else if (result.second && partial_insertion_sort(first, pivot_pos, comp) && partial_insertion_sort(pivot_pos + 1, last, comp))
+					return;
+
+				pdqsort_loop(first, pivot_pos, comp, bad_allowed, leftmost, branchless);
+				first = pivot_pos + 1;
+				leftmost = false;
+			}
+		}
+
+		// Merges the sorted ranges [first, middle) and [middle, last) stably.  The shorter side is
+		// moved into the scratch buffer when it fits; otherwise the larger side is split at its
+		// midpoint, the matching split point found in the other side by binary search, the middle
+		// sections rotated into place, and both halves merged recursively.
+		template <class Iterator, class BufferIterator, class Compare>
+		void merge_adaptive(Iterator first, Iterator middle, Iterator last, BufferIterator buffer, std::ptrdiff_t buffer_size, Compare comp)
+		{
+			if (first == middle || middle == last)
+				return;
+
+			// Elements already in their final place need not be moved.
+			first = std::upper_bound(first, middle, *middle, comp);
+			if (first == middle)
+				return;
+			last = std::lower_bound(middle, last, *std::prev(middle), comp);
+
+			auto n1 = std::distance(first, middle), n2 = std::distance(middle, last);
+			if (n1 <= n2 && n1 <= buffer_size)
+			{
+				auto buffer_last = std::move(first, middle, buffer);
+				auto b = buffer, out = first;
+				while (b != buffer_last && middle != last)
+					*out++ = comp(*middle, *b) ? std::move(*middle++) : std::move(*b++);
+				std::move(b, buffer_last, out);
+			}
+			else if (n2 <= buffer_size)
+			{
+				auto buffer_last = std::move(middle, last, buffer);
+				auto b = buffer_last, out = last;
+				while (b != buffer && middle != first)
+					*--out = comp(*std::prev(b), *std::prev(middle)) ? std::move(*--middle) : std::move(*--b);
+				std::move_backward(buffer, b, out);
+			}
+			else if (n1 + n2 == 2)
+				std::iter_swap(first, middle);
+			else
+			{
+				Iterator cut1, cut2;
+				if (n1 > n2)
+				{
+					cut1 = std::next(first, n1 / 2);
+					cut2 = std::lower_bound(middle, last, *cut1, comp);
+				}
+				else
+				{
+					cut2 = std::next(middle, n2 / 2);
+					cut1 = std::upper_bound(first, middle, *cut2, comp);
+				}
+				auto new_middle = std::rotate(cut1, middle, cut2);
+				merge_adaptive(first, cut1, new_middle, buffer, buffer_size, comp);
+				merge_adaptive(new_middle, cut2, last, buffer, buffer_size, comp);
+			}
+		}
+
+		// Sorts [first, last), first checking in a single pass for input that is already one
+		// ascending or descending run, or an ascending run with a short unsorted tail.  The tail is
+		// sorted and merged through a buffer of its length; if that cannot be allocated, through
+		// what can, down to merging by rotations, so sorting never throws bad_alloc.
+		template <class Iterator, class Compare>
+		void pdqsort(Iterator first, Iterator last, Compare comp)
+		{
+			typedef typename std::iterator_traits<Iterator>::value_type value_type;
+			typedef is_branchless_compare<Compare, value_type> branchless;
+			auto size = last - first;
+			if (size < 2)
+				return;
+			if (branchless::value && size <= sort_network_limit)
+			{
+				network_sort(first, last, comp, branchless());
+				return;
+			}
+
+			auto run = first + 1;
+			if (comp(*run, *first))
+			{
+				while (run != last && !comp(*(run - 1), *run))
+					++run;
+				if (run == last)
+				{
+					std::reverse(first, last);
+					return;
+				}
+			}
+			else
+			{
+				while (run != last && !comp(*run, *(run - 1)))
+					++run;
+				if (run == last)
+					return;
+				if (last - run <= size / 16)
+				{
+					pdqsort(run, last, comp);
+					temporary_buffer<value_type> buffer(run, static_cast<std::size_t>(last - run));
+					merge_adaptive(first, run, last, buffer.data(), buffer.size(), comp);
+					return;
+				}
+			}
+
+			pdqsort_loop(first, last, comp, pdq_log2(size), true, branchless());
+		}
+
+		// Below this length, comparison sorting beats the fixed cost of the radix passes.
+		const std::ptrdiff_t radix_sort_threshold = 4096;
+
+		// Ranges whose elements are stored contiguously in memory.
+		template <class Range>
+		struct is_contiguous : std::false_type
+		{
+		};
+
+		template <class Iterator>
+		struct is_contiguous<iterator_range<Iterator>> : std::integral_constant<bool,
+			std::is_pointer<Iterator>::value
+			|| (std::is_same<Iterator, typename std::vector<typename std::iterator_traits<Iterator>::value_type>::iterator>::value
+				&& !std::is_same<typename std::iterator_traits<Iterator>::value_type, bool>::value)>
+		{
+		};
+
+		// Ranges whose elements are arithmetic values stored contiguously.
+		template <class Range>
+		struct is_contiguous_arithmetic : std::integral_constant<bool,
+			is_contiguous<Range>::value && std::is_arithmetic<typename range_traits<Range>::value_type>::value>
+		{
+		};
+
+		// Arithmetic types that radix_key can map to an unsigned integer: all integers, and
+		// floating point types of 4 or 8 bytes.
+		template <class T>
+		struct has_radix_key : std::integral_constant<bool,
+			std::is_integral<T>::value || (std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8))>
+		{
+		};
+
+		template<class RandomAccessRange>
+		void sort(const RandomAccessRange& range, std::false_type /* radix */)
+		{
+			pdqsort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
+					range_iterator<RandomAccessRange>(range, range.end_pos()),
+					std::less<>());
+		}
+
+		template<class RandomAccessRange>
+		void sort(const RandomAccessRange& range, std::true_type /* radix */)
+		{
+			if (length(range) < radix_sort_threshold)
+				sort(range, std::false_type());
+			else
+				radix_sort(range);
+		}
+	}
+
+	// Large contiguous ranges of integers, floats and doubles are radix sorted.
 	template<class RandomAccessRange>
 	void sort(const RandomAccessRange& range)
 	{
-		std::sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
-				  range_iterator<RandomAccessRange>(range, range.end_pos()));
+		typedef typename std::remove_cv<typename range_traits<RandomAccessRange>::value_type>::type value_type;
+		detail::sort(range, std::integral_constant<bool,
+			detail::is_contiguous_arithmetic<RandomAccessRange>::value && detail::has_radix_key<value_type>::value>());
 	}
 
 	template<class RandomAccessRange, class Compare>
 	void sort(const RandomAccessRange& range, Compare comp)
 	{
-		std::sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
-				  range_iterator<RandomAccessRange>(range, range.end_pos()),
-				  comp);
+		detail::pdqsort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
+						range_iterator<RandomAccessRange>(range, range.end_pos()),
+						comp);
+	}
+
+	namespace detail
+	{
+		template <std::size_t N>
+		struct is_fixed_network : is_fixed_unrolled<N, static_cast<std::size_t>(sort_network_limit)>
+		{
+		};
+
+		template<class T, std::size_t N, class Compare>
+		void sort(const fixed_range<T, N>& range, Compare comp, std::false_type /* is_fixed_network */)
+		{
+			pdqsort(range.begin_pos(), range.end_pos(), comp);
+		}
+
+		template<class T, std::size_t N, class Compare>
+		void sort(const fixed_range<T, N>& range, Compare comp, std::true_type /* is_fixed_network */)
+		{
+			if (!is_full(range))
+				pdqsort(range.begin_pos(), range.end_pos(), comp);
+			else
+				unrolled_network_sort<N>(range.begin_pos(), comp, is_branchless_compare<Compare, typename std::remove_const<T>::type>(),
+										 std::make_index_sequence<sorting_network<N>::comparators.count>());
+		}
+	}
+
+	// An array of known length up to sort_network_limit is sorted by a sorting network expanded
+	// into straight-line code.
+	template<class T, std::size_t N>
+	void sort(const fixed_range<T, N>& range)
+	{
+		detail::sort(range, std::less<>(), detail::is_fixed_network<N>());
+	}
+
+	template<class T, std::size_t N, class Compare>
+	void sort(const fixed_range<T, N>& range, Compare comp)
+	{
+		detail::sort(range, comp, detail::is_fixed_network<N>());
+	}
+
+	namespace detail
+	{
+		// Runs shorter than this are extended by insertion sort before merging.
+		const std::ptrdiff_t min_run = 32;
+
+		// Returns the end of the run beginning at first, reversing it if it is strictly
+		// descending, and extending it to min_run elements if it is shorter.
+		template <class Iterator, class Compare>
+		Iterator next_run(Iterator first, Iterator last, Compare comp)
+		{
+			auto run = first + 1;
+			if (run == last)
+				return last;
+			if (comp(*run, *first))
+			{
+				while (run + 1 != last && comp(*(run + 1), *run))
+					++run;
+				std::reverse(first, ++run);
+			}
+			else
+			{
+				while (run + 1 != last && !comp(*(run + 1), *run))
+					++run;
+				++run;
+			}
+
+			if (run - first < min_run)
+			{
+				auto end = last - first <= min_run ? last : first + min_run;
+				for (; run != end; ++run)
+				{
+					auto sift = run;
+					if (comp(*sift, *(sift - 1)))
+					{
+						typename std::iterator_traits<Iterator>::value_type value = std::move(*sift);
+						do *sift = std::move(*(sift - 1));
+						while (--sift != first && comp(value, *(sift - 1)));
+						*sift = std::move(value);
+					}
+				}
+			}
+			return run;
+		}
+
+		// The depth in a perfectly balanced merge tree over n elements of the boundary between
+		// the adjacent runs [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2): the position of the first
+		// bit at which the binary expansions of their midpoints, as fractions of n, differ.
+		inline int run_power(std::ptrdiff_t s1, std::ptrdiff_t n1, std::ptrdiff_t n2, std::ptrdiff_t n)
+		{
+			int power = 0;
+			auto a = 2 * s1 + n1, b = a + n1 + n2;
+			for (;;)
+			{
+				++power;
+				if (a >= n)
+				{
+					a -= n;
+					b -= n;
+				}
+				else if (b >= n)
+					break;
+				a <<= 1;
+				b <<= 1;
+			}
+			return power;
+		}
+
+		// Powersort (Munro and Wild): natural runs are pushed on a stack with the power of the
+		// boundary before them, and runs are merged whenever the new boundary is shallower than the
+		// one below it, so merges follow a nearly optimal tree over the actual runs.  Input that is
+		// already one run costs a single pass.  Powers strictly decrease up the stack, so it never
+		// holds more than one run per bit of the length.
+		template <class Iterator, class BufferIterator, class Compare>
+		void powersort(Iterator first, Iterator last, BufferIterator buffer, std::ptrdiff_t buffer_size, Compare comp)
+		{
+			auto n = last - first;
+			if (n < 2)
+				return;
+
+			struct run { Iterator first; int power; };
+			run stack[8 * sizeof(std::ptrdiff_t) + 1];
+			std::size_t height = 0;
+
+			auto run_first = first, run_last = next_run(first, last, comp);
+			while (run_last != last)
+			{
+				auto next_last = next_run(run_last, last, comp);
+				auto power = run_power(run_first - first, run_last - run_first, next_last - run_last, n);
+				while (height != 0 && stack[height - 1].power > power)
+				{
+					auto left = stack[--height].first;
+					merge_adaptive(left, run_first, run_last, buffer, buffer_size, comp);
+					run_first = left;
+				}
+				stack[height++] = { run_first, power };
+				run_first = run_last;
+				run_last = next_last;
+			}
+			while (height != 0)
+			{
+				auto left = stack[--height].first;
+				merge_adaptive(left, run_first, last, buffer, buffer_size, comp);
+				run_first = left;
+			}
+		}
+
 	}
 
 	template<class RandomAccessRange>
 	void stable_sort(const RandomAccessRange& range)
 	{
-		std::stable_sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
-						 range_iterator<RandomAccessRange>(range, range.end_pos()));
+		stable_sort(range, std::less<>());
 	}
 
+	// An adaptive merge sort over the natural runs of the range; see detail::powersort.  A
+	// scratch buffer of half the range's length is allocated for merging.
 	template<class RandomAccessRange, class Compare>
 	void stable_sort(const RandomAccessRange& range, Compare comp)
 	{
-		std::stable_sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
-						 range_iterator<RandomAccessRange>(range, range.end_pos()),
-						 comp);
+		typedef typename std::remove_cv<typename range_traits<RandomAccessRange>::value_type>::type value_type;
+		range_iterator<RandomAccessRange> first(range, range.begin_pos()), last(range, range.end_pos());
+		detail::temporary_buffer<value_type> buffer(first, static_cast<std::size_t>((last - first) / 2));
+		detail::powersort(first, last, buffer.data(), buffer.size(), comp);
+	}
+
+	// As above, merging through the elements of the caller's scratch range rather than
+	// allocating.  A scratch range of half the length of the range gives the same performance;
+	// shorter ones, down to empty, fall back to rotation-based merging for the merges that do
+	// not fit.
+	template<class RandomAccessRange, class Compare, class ScratchRange>
+	void stable_sort(const RandomAccessRange& range, Compare comp, const ScratchRange& scratch)
+	{
+		detail::powersort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
+						  range_iterator<RandomAccessRange>(range, range.end_pos()),
+						  range_iterator<ScratchRange>(scratch, scratch.begin_pos()), length(scratch), comp);
 	}
 
 	template<class RandomAccessRange>
-	void partial_sort(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type middle)
+	void stable_sort(const RandomAccessRange& range, scratch_buffer& scratch)
 	{
-		std::partial_sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
-						  range_iterator<RandomAccessRange>(range, middle),
-						  range_iterator<RandomAccessRange>(range, range.end_pos()));
+		stable_sort(range, std::less<>(), scratch);
 	}
 
+	// As above, merging through as much of half the range's length as the scratch buffer holds.
 	template<class RandomAccessRange, class Compare>
-	void partial_sort(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type middle, Compare comp)
+	void stable_sort(const RandomAccessRange& range, Compare comp, scratch_buffer& scratch)
 	{
-		std::partial_sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
-						  range_iterator<RandomAccessRange>(range, middle),
+		typedef typename std::remove_cv<typename range_traits<RandomAccessRange>::value_type>::type value_type;
+		detail::scratch_array<value_type> buffer(scratch, static_cast<std::size_t>(length(range) / 2));
+		detail::powersort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
 						  range_iterator<RandomAccessRange>(range, range.end_pos()),
-						  comp);
+						  buffer.data(), buffer.size(), comp);
 	}
 
-	template<class InputRange, class RandomAccessRange>
-	typename range_traits<RandomAccessRange>::position_type partial_sort_copy(const InputRange& range, RandomAccessRange result_range)
+	namespace detail
 	{
-		return std::partial_sort_copy(range_iterator<InputRange>(range, range.begin_pos()),
-									  range_iterator<InputRange>(range, range.end_pos()),
-									  range_iterator<RandomAccessRange>(result_range, result_range.begin_pos()),
-									  range_iterator<RandomAccessRange>(result_range, result_range.end_pos())).pos();
+		// Maps an arithmetic key to an unsigned integer of the same width whose unsigned ordering
+		// matches the key's ordering.  Signed integers have their sign bit flipped; floating point
+		// values have every bit flipped if negative and only the sign bit flipped otherwise.
+		template <class T, class Enable = void>
+		struct radix_key;
+
+		template <class T>
+		struct radix_key<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+		{
+			typedef typename std::make_unsigned<T>::type bits_type;
+
+			static bits_type bits(T key)
+			{
+				const bits_type sign = std::is_signed<T>::value ? bits_type(1) << (8 * sizeof(T) - 1) : 0;
+				return static_cast<bits_type>(key) ^ sign;
+			}
+		};
+
+		template <>
+		struct radix_key<bool>
+		{
+			typedef unsigned char bits_type;
+
+			static bits_type bits(bool key) { return key; }
+		};
+
+		template <class T>
+		struct radix_key<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+		{
+			static_assert(sizeof(T) == 4 || sizeof(T) == 8, "stdext::radix_sort: unsupported floating point key width");
+			typedef typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type bits_type;
+
+			static bits_type bits(T key)
+			{
+				const bits_type sign = bits_type(1) << (8 * sizeof(T) - 1);
+				bits_type bits;
+				std::memcpy(&bits, &key, sizeof(bits));
+				return bits & sign ? ~bits : bits | sign;
+			}
+		};
+
+		struct radix_identity
+		{
+			template <class T>
+			const T& operator () (const T& value) const { return value; }
+		};
+
+		// Runs f(0), ..., f(threads - 1), each on its own thread except the first.
+		template <class Function>
+		void for_each_worker(unsigned threads, Function f)
+		{
+			std::vector<std::thread> workers;
+			workers.reserve(threads - 1);
+			for (unsigned i = 1; i < threads; ++i)
+				workers.emplace_back(f, i);
+			f(0);
+			for (auto& worker : workers)
+				worker.join();
+		}
+
+		// LSD radix sort of the n values by key, one byte per pass, ping-ponging between the two
+		// buffers; returns the buffer that holds the sorted values.  Each worker scatters its own
+		// contiguous slice, with offsets assigned in slice order, so the sort is stable.  A single
+		// worker histograms every digit in one scan up front; several workers must recount their
+		// slices before each pass.  Passes in which every key has the same byte are skipped.
+		template <class T, class KeyFunction>
+		T* radix_sort_buffers(T* values, T* scratch, std::size_t n, KeyFunction key, unsigned threads)
+		{
+			typedef typename std::decay<decltype(key(*values))>::type key_type;
+			typedef radix_key<key_type> traits;
+			const std::size_t radix = 256, digits = sizeof(typename traits::bits_type);
+
+			std::vector<std::size_t> counts(threads * radix), histograms;
+			if (threads == 1)
+			{
+				histograms.resize(digits * radix);
+				for (std::size_t i = 0; i != n; ++i)
+				{
+					auto bits = traits::bits(key(values[i]));
+					for (std::size_t digit = 0; digit != digits; ++digit)
+						++histograms[digit * radix + (bits >> 8 * digit & 0xFF)];
+				}
+			}
+
+			for (std::size_t digit = 0; digit != digits; ++digit)
+			{
+				auto shift = 8 * digit;
+				if (threads == 1)
+				{
+					std::copy(histograms.begin() + digit * radix, histograms.begin() + (digit + 1) * radix, counts.begin());
+				}
+				else
+				{
+					std::fill(counts.begin(), counts.end(), 0);
+					for_each_worker(threads, [&](unsigned worker)
+					{
+						auto count = &counts[worker * radix];
+						for (auto i = n * worker / threads, last = n * (worker + 1) / threads; i != last; ++i)
+							++count[traits::bits(key(values[i])) >> shift & 0xFF];
+					});
+				}
+
+				std::size_t offset = 0;
+				bool trivial = false;
+				for (std::size_t bucket = 0; bucket != radix; ++bucket)
+				{
+					auto start = offset;
+					for (unsigned worker = 0; worker != threads; ++worker)
+					{
+						auto count = counts[worker * radix + bucket];
+						counts[worker * radix + bucket] = offset;
+						offset += count;
+					}
+					trivial = trivial || offset - start == n;
+				}
+				if (trivial)
+					continue;
+
+				for_each_worker(threads, [&](unsigned worker)
+				{
+					auto next = &counts[worker * radix];
+					for (auto i = n * worker / threads, last = n * (worker + 1) / threads; i != last; ++i)
+						scratch[next[traits::bits(key(values[i])) >> shift & 0xFF]++] = std::move(values[i]);
+				});
+				std::swap(values, scratch);
+			}
+
+			return values;
+		}
+
+		// Contiguous ranges are sorted in place, ping-ponging between their own storage and a
+		// single scratch buffer.
+		template<class RandomAccessRange, class KeyFunction>
+		void radix_sort(const RandomAccessRange& range, KeyFunction key, unsigned threads, std::true_type /* is_contiguous */)
+		{
+			typedef typename std::remove_cv<typename range_traits<RandomAccessRange>::value_type>::type value_type;
+			auto n = static_cast<std::size_t>(length(range));
+			auto values = std::addressof(range.at_pos(range.begin_pos()));
+			std::vector<value_type> scratch(n);
+			if (radix_sort_buffers(values, scratch.data(), n, key, threads) != values)
+				std::move(scratch.begin(), scratch.end(), values);
+		}
+
+		template<class RandomAccessRange, class KeyFunction>
+		void radix_sort(const RandomAccessRange& range, KeyFunction key, unsigned threads, std::false_type /* is_contiguous */)
+		{
+			typedef typename std::remove_cv<typename range_traits<RandomAccessRange>::value_type>::type value_type;
+			auto n = static_cast<std::size_t>(length(range));
+			std::vector<value_type> values, scratch(n);
+			values.reserve(n);
+			for (auto p = range.begin_pos(), last = range.end_pos(); p != last; range.increment_pos(p))
+				values.push_back(std::move(range.at_pos(p)));
+			auto i = radix_sort_buffers(values.data(), scratch.data(), n, key, threads);
+			for (auto p = range.begin_pos(), last = range.end_pos(); p != last; range.increment_pos(p))
+				range.at_pos(p) = std::move(*i++);
+		}
+
+		template<class RandomAccessRange, class KeyFunction>
+		void radix_sort(const RandomAccessRange& range, KeyFunction key, unsigned threads)
+		{
+			auto n = length(range);
+			if (n < 2)
+				return;
+			threads = std::max(1u, std::min(threads, static_cast<unsigned>(n / radix_sort_threshold)));
+			radix_sort(range, key, threads, is_contiguous<RandomAccessRange>());
+		}
+	}
+
+	template<class RandomAccessRange>
+	void radix_sort(const RandomAccessRange& range)
+	{
+		radix_sort(range, detail::radix_identity());
+	}
+
+	// Sorts stably by an arithmetic key, in O(n) passes between the range and a scratch buffer
+	// of n elements (two buffers if the range is not contiguous).
+	template<class RandomAccessRange, class KeyFunction>
+	void radix_sort(const RandomAccessRange& range, KeyFunction key)
+	{
+		detail::radix_sort(range, key, 1);
+	}
+
+	template<class RandomAccessRange>
+	void parallel_radix_sort(const RandomAccessRange& range)
+	{
+		parallel_radix_sort(range, detail::radix_identity());
+	}
+
+	// As radix_sort, with each pass split across the hardware threads.
+	template<class RandomAccessRange, class KeyFunction>
+	void parallel_radix_sort(const RandomAccessRange& range, KeyFunction key)
+	{
+		detail::radix_sort(range, key, std::thread::hardware_concurrency());
+	}
+
+	namespace detail
+	{
+		// Reorders range so that the element at index i is the one originally at index
+		// permutation[i], following each cycle of the permutation with swaps.  permutation is
+		// consumed in the process.
+		template <class RandomAccessRange, class Index>
+		void apply_permutation(const RandomAccessRange& range, std::vector<Index>& permutation)
+		{
+			typedef range_iterator<RandomAccessRange> iterator;
+			iterator first(range, range.begin_pos());
+			auto done = static_cast<Index>(permutation.size());
+			for (Index i = 0; i != done; ++i)
+			{
+				auto j = i;
+				while (permutation[j] != done)
+				{
+					auto k = permutation[j];
+					permutation[j] = done;
+					if (k == i)
+						break;
+					std::iter_swap(first + j, first + k);
+					j = k;
+				}
+			}
+		}
+
+		// Characters of a string key, viewed as a pointer and length.  Keys may be any contiguous
+		// character container or view with data() and size(), or a subrange of characters.
+		struct string_key
+		{
+			const char* chars;
+			std::size_t size;
+			std::size_t index;
+
+			// The character at depth d, offset by one so that the end of the string sorts first.
+			int at(std::size_t d) const { return d < size ? static_cast<unsigned char>(chars[d]) + 1 : 0; }
+		};
+
+		template <class Key>
+		auto string_key_chars(const Key& key) -> decltype(std::make_pair<const char*, std::size_t>(key.data(), key.size()))
+		{
+			return { key.data(), key.size() };
+		}
+
+		template <class Char>
+		std::pair<const char*, std::size_t> string_key_chars(const iterator_range<Char*>& key)
+		{
+			static_assert(sizeof(Char) == 1, "stdext::string_sort: key is not a character range");
+			return { reinterpret_cast<const char*>(key.begin_pos()), static_cast<std::size_t>(key.end_pos() - key.begin_pos()) };
+		}
+
+		// Orders a and b by their characters from depth d onward; earlier characters are known to
+		// be equal.
+		inline bool string_key_less(const string_key& a, const string_key& b, std::size_t d)
+		{
+			auto n = std::min(a.size, b.size);
+			if (d < n)
+			{
+				auto c = std::memcmp(a.chars + d, b.chars + d, n - d);
+				if (c != 0)
+					return c < 0;
+			}
+			return a.size < b.size;
+		}
+
+		// Multikey quicksort (Bentley and Sedgewick): partitions three ways on a single character at
+		// the current depth and only descends a level within the equal partition, so a common
+		// prefix is examined once per partitioning step rather than once per comparison.
+		inline void multikey_quicksort(string_key* first, string_key* last, std::size_t d)
+		{
+			const std::ptrdiff_t insertion_threshold = 16;
+			while (last - first > insertion_threshold)
+			{
+				auto n = last - first;
+				int a = first->at(d), b = first[n / 2].at(d), c = last[-1].at(d);
+				int pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+				// Dutch national flag partition into [first, lt) < pivot, [lt, gt) == pivot, [gt, last) > pivot.
+				auto lt = first, i = first, gt = last;
+				while (i != gt)
+				{
+					int ch = i->at(d);
+					if (ch < pivot)
+						std::swap(*lt++, *i++);
+					else if (ch > pivot)
+						std::swap(*i, *--gt);
+					else
+						++i;
+				}
+
+				multikey_quicksort(first, lt, d);
+				multikey_quicksort(gt, last, d);
+				if (pivot == 0)
+					return;
+				first = lt;
+				last = gt;
+				++d;
+			}
+
+			for (auto i = first; i != last; ++i)
+			{
+				auto key = *i;
+				auto j = i;
+				for (; j != first && string_key_less(key, j[-1], d); --j)
+					*j = j[-1];
+				*j = key;
+			}
+		}
+
+		struct string_identity
+		{
+			template <class T>
+			const T& operator () (const T& value) const { return value; }
+		};
+	}
+
+	template<class RandomAccessRange>
+	void string_sort(const RandomAccessRange& range)
+	{
+		string_sort(range, detail::string_identity());
+	}
+
+	// Sorts by a string key: std::string, any view with data() and size(), or a character
+	// subrange such as those yielded by split().  Keys are cached as pointers into the elements
+	// and sorted by multikey quicksort, after which the elements are permuted into place.  The
+	// key function must return either a view or a reference to a string held by the element.
+	template<class RandomAccessRange, class KeyFunction>
+	void string_sort(const RandomAccessRange& range, KeyFunction key)
+	{
+		typedef decltype(key(range.at_pos(range.begin_pos()))) key_result;
+		static_assert(std::is_lvalue_reference<key_result>::value || !std::is_same<typename std::decay<key_result>::type, std::string>::value,
+			"stdext::string_sort: key function returns a temporary string");
+
+		std::vector<detail::string_key> keys;
+		keys.reserve(static_cast<std::size_t>(length(range)));
+		for (auto p = range.begin_pos(), last = range.end_pos(); p != last; range.increment_pos(p))
+		{
+			auto chars = detail::string_key_chars(key(range.at_pos(p)));
+			keys.push_back({ chars.first, chars.second, keys.size() });
+		}
+		detail::multikey_quicksort(keys.data(), keys.data() + keys.size(), 0);
+
+		std::vector<std::size_t> permutation;
+		permutation.reserve(keys.size());
+		for (const auto& k : keys)
+			permutation.push_back(k.index);
+		detail::apply_permutation(range, permutation);
+	}
+
+	namespace detail
+	{
+		// Sorts the cached keys: by radix if there are enough of them and they have a radix key in
+		// its natural order (radix sorting is stable), otherwise by comparison, stably if asked to.
+		template <class Key, class Index, class Compare>
+		void sort_key_cache(std::vector<std::pair<Key, Index>>& keys, Compare comp, std::false_type /* stable */, std::false_type /* radix */)
+		{
+			stdext::sort(make_range(keys), [&](const std::pair<Key, Index>& a, const std::pair<Key, Index>& b) { return comp(a.first, b.first); });
+		}
+
+		template <class Key, class Index, class Compare>
+		void sort_key_cache(std::vector<std::pair<Key, Index>>& keys, Compare comp, std::true_type /* stable */, std::false_type /* radix */)
+		{
+			stdext::stable_sort(make_range(keys), [&](const std::pair<Key, Index>& a, const std::pair<Key, Index>& b) { return comp(a.first, b.first); });
+		}
+
+		template <class Key, class Index, class Compare, class Stable>
+		void sort_key_cache(std::vector<std::pair<Key, Index>>& keys, Compare comp, Stable stable, std::true_type /* radix */)
+		{
+			if (keys.size() < static_cast<std::size_t>(radix_sort_threshold))
+				return sort_key_cache(keys, comp, stable, std::false_type());
+
+			std::vector<std::pair<Key, Index>> scratch(keys.size());
+			if (radix_sort_buffers(keys.data(), scratch.data(), keys.size(), [](const std::pair<Key, Index>& k) { return k.first; }, 1) != keys.data())
+				keys.swap(scratch);
+		}
+
+		template <class Index, class RandomAccessRange, class KeyFunction, class Compare, class Stable>
+		void sort_by_key(const RandomAccessRange& range, KeyFunction key, Compare comp, Stable stable)
+		{
+			typedef typename std::decay<decltype(key(range.at_pos(range.begin_pos())))>::type key_type;
+			typedef std::integral_constant<bool, has_radix_key<key_type>::value
+				&& (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<key_type>>::value)> radix;
+
+			std::vector<std::pair<key_type, Index>> keys;
+			keys.reserve(static_cast<std::size_t>(length(range)));
+			for (auto p = range.begin_pos(), last = range.end_pos(); p != last; range.increment_pos(p))
+				keys.emplace_back(key(range.at_pos(p)), static_cast<Index>(keys.size()));
+			sort_key_cache(keys, comp, stable, radix());
+
+			std::vector<Index> permutation;
+			permutation.reserve(keys.size());
+			for (const auto& k : keys)
+				permutation.push_back(k.second);
+			keys = { };
+			apply_permutation(range, permutation);
+		}
+
+		template <class RandomAccessRange, class KeyFunction, class Compare, class Stable>
+		void sort_by_key(const RandomAccessRange& range, KeyFunction key, Compare comp, Stable stable)
+		{
+			if (static_cast<std::uint64_t>(length(range)) < std::numeric_limits<std::uint32_t>::max())
+				sort_by_key<std::uint32_t>(range, key, comp, stable);
+			else
+				sort_by_key<std::size_t>(range, key, comp, stable);
+		}
+	}
+
+	template<class RandomAccessRange, class KeyFunction>
+	void sort_by_key(const RandomAccessRange& range, KeyFunction key)
+	{
+		sort_by_key(range, key, std::less<>());
+	}
+
+	// Sorts the range by key(element), calling key once per element.  The keys are cached with
+	// their indices in a compact array, which is sorted (by radix for many integer, float or
+	// double keys in their natural order) and then applied to the range by following the cycles
+	// of the permutation, so each element is moved only a few times.
+	template<class RandomAccessRange, class KeyFunction, class Compare>
+	void sort_by_key(const RandomAccessRange& range, KeyFunction key, Compare comp)
+	{
+		detail::sort_by_key(range, key, comp, std::false_type());
+	}
+
+	template<class RandomAccessRange, class KeyFunction>
+	void stable_sort_by_key(const RandomAccessRange& range, KeyFunction key)
+	{
+		stable_sort_by_key(range, key, std::less<>());
+	}
+
+	// As sort_by_key, keeping elements with equivalent keys in their original order.
+	template<class RandomAccessRange, class KeyFunction, class Compare>
+	void stable_sort_by_key(const RandomAccessRange& range, KeyFunction key, Compare comp)
+	{
+		detail::sort_by_key(range, key, comp, std::true_type());
+	}
+
+	namespace detail
+	{
+		// Short ranges of cheaply compared values are sorted outright by a sorting network,
+		// which satisfies the postconditions of partial_sort and nth_element alike.
+		template<class RandomAccessRange, class Compare>
+		bool network_sort_small(const RandomAccessRange& range, Compare comp)
+		{
+			typedef is_branchless_compare<Compare, typename range_traits<RandomAccessRange>::value_type> branchless;
+			if (!branchless::value || length(range) > sort_network_limit)
+				return false;
+			network_sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
+						 range_iterator<RandomAccessRange>(range, range.end_pos()),
+						 comp, branchless());
+			return true;
+		}
+	}
+
+	template<class RandomAccessRange>
+	void partial_sort(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type middle)
+	{
+		if (detail::network_sort_small(range, std::less<>()))
+			return;
+		std::partial_sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
+						  range_iterator<RandomAccessRange>(range, middle),
+						  range_iterator<RandomAccessRange>(range, range.end_pos()));
+	}
+
+	template<class RandomAccessRange, class Compare>
+	void partial_sort(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type middle, Compare comp)
+	{
+		if (detail::network_sort_small(range, comp))
+			return;
+		std::partial_sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
+						  range_iterator<RandomAccessRange>(range, middle),
+						  range_iterator<RandomAccessRange>(range, range.end_pos()),
+						  comp);
+	}
+
+	template<class InputRange, class RandomAccessRange>
+	typename range_traits<RandomAccessRange>::position_type partial_sort_copy(const InputRange& range, RandomAccessRange result_range)
+	{
+		return std::partial_sort_copy(range_iterator<InputRange>(range, range.begin_pos()),
+									  range_iterator<InputRange>(range, range.end_pos()),
+									  range_iterator<RandomAccessRange>(result_range, result_range.begin_pos()),
+									  range_iterator<RandomAccessRange>(result_range, result_range.end_pos())).pos();
 	}
 
 	template<class InputRange, class RandomAccessRange, class Compare>
@@ -672,6 +2520,8 @@ namespace stdext
 	template<class RandomAccessRange>
 	void nth_element(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type nth)
 	{
+		if (detail::network_sort_small(range, std::less<>()))
+			return;
 		std::nth_element(range_iterator<RandomAccessRange>(range, range.begin_pos()),
 						 range_iterator<RandomAccessRange>(range, nth),
 						 range_iterator<RandomAccessRange>(range, range.end_pos()));
@@ -680,26 +2530,285 @@ namespace stdext
 	template<class RandomAccessRange, class Compare>
 	void nth_element(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type nth, Compare comp)
 	{
+		if (detail::network_sort_small(range, comp))
+			return;
 		std::nth_element(range_iterator<RandomAccessRange>(range, range.begin_pos()),
 						 range_iterator<RandomAccessRange>(range, nth),
 						 range_iterator<RandomAccessRange>(range, range.end_pos()),
 						 comp);
 	}
 
+	namespace detail
+	{
+		// Selection is split across workers only when each gets at least this many elements.
+		const std::ptrdiff_t parallel_select_threshold = 1 << 16;
+
+		template <class Iterator, class Compare>
+		void parallel_nth_element(Iterator first, Iterator nth, Iterator last, Compare comp, unsigned, std::false_type /* is_default_constructible */)
+		{
+			std::nth_element(first, nth, last, comp);
+		}
+
+		// Picks two splitters from a sorted random sample that bracket the nth element with high
+		// probability.  Each worker classifies its slice as below, between or above them and moves
+		// its elements into the matching region of a buffer, at offsets assigned in slice order,
+		// then the buffer is moved back.  Only the region holding nth, usually a small fraction of
+		// the range, remains to be searched.
+		template <class Iterator, class Compare>
+		void parallel_nth_element(Iterator first, Iterator nth, Iterator last, Compare comp, unsigned threads, std::true_type /* is_default_constructible */)
+		{
+			typedef typename std::iterator_traits<Iterator>::value_type value_type;
+			const std::ptrdiff_t samples = 4096, margin = 64;
+
+			auto n = last - first;
+			auto workers = static_cast<unsigned>(std::min<std::ptrdiff_t>(threads, n / parallel_select_threshold));
+			if (workers < 2)
+			{
+				std::nth_element(first, nth, last, comp);
+				return;
+			}
+
+			std::vector<value_type> sample;
+			sample.reserve(samples);
+			std::minstd_rand engine(static_cast<unsigned>(n));
+			std::uniform_int_distribution<std::ptrdiff_t> pick(0, n - 1);
+			for (std::ptrdiff_t i = 0; i != samples; ++i)
+				sample.push_back(first[pick(engine)]);
+			pdqsort(sample.begin(), sample.end(), comp);
+			auto rank = (nth - first) * samples / n;
+			const value_type& low = sample[std::max<std::ptrdiff_t>(rank - margin, 0)];
+			const value_type& high = sample[std::min(rank + margin, samples - 1)];
+			auto classify = [&](const value_type& value) { return comp(value, low) ? 0 : comp(high, value) ? 2 : 1; };
+
+			std::vector<std::ptrdiff_t> offsets(workers * 3);
+			for_each_worker(workers, [&](unsigned worker)
+			{
+				auto count = &offsets[worker * 3];
+				for (auto i = n * worker / workers, i_last = n * (worker + 1) / workers; i != i_last; ++i)
+					++count[classify(first[i])];
+			});
+			std::ptrdiff_t bounds[4], offset = 0;
+			for (unsigned region = 0; region != 3; ++region)
+			{
+				bounds[region] = offset;
+				for (unsigned worker = 0; worker != workers; ++worker)
+				{
+					auto count = offsets[worker * 3 + region];
+					offsets[worker * 3 + region] = offset;
+					offset += count;
+				}
+			}
+			bounds[3] = n;
+
+			std::vector<value_type> buffer(n);
+			for_each_worker(workers, [&](unsigned worker)
+			{
+				auto next = &offsets[worker * 3];
+				for (auto i = n * worker / workers, i_last = n * (worker + 1) / workers; i != i_last; ++i)
+					buffer[next[classify(first[i])]++] = std::move(first[i]);
+			});
+			for_each_worker(workers, [&](unsigned worker)
+			{
+				auto i = n * worker / workers, i_last = n * (worker + 1) / workers;
+				std::move(buffer.begin() + i, buffer.begin() + i_last, first + i);
+			});
+
+			auto k = nth - first;
+			auto region = k < bounds[1] ? 0 : k < bounds[2] ? 1 : 2;
+			if (bounds[region + 1] - bounds[region] == n)
+				std::nth_element(first, nth, last, comp);
+			else
+				parallel_nth_element(first + bounds[region], nth, first + bounds[region + 1], comp, threads, std::true_type());
+		}
+
+		// For a prefix short enough, each worker moves the best elements of its slice to the front
+		// of the slice, and the best overall are selected from these candidates, gathered at the
+		// front of the range.  Otherwise the prefix is split off by a parallel nth_element and
+		// then sorted.
+		template <class Iterator, class Compare>
+		void parallel_partial_sort(Iterator first, Iterator middle, Iterator last, Compare comp, unsigned threads)
+		{
+			typedef typename std::iterator_traits<Iterator>::value_type value_type;
+			auto n = last - first, k = middle - first;
+			if (k == 0)
+				return;
+
+			auto workers = static_cast<unsigned>(std::min<std::ptrdiff_t>(threads, n / std::max(parallel_select_threshold, 2 * k)));
+			if (workers >= 2)
+			{
+				for_each_worker(workers, [&](unsigned worker)
+				{
+					std::nth_element(first + n * worker / workers, first + (n * worker / workers + k), first + n * (worker + 1) / workers, comp);
+				});
+				// Slices hold at least 2k elements, so no slice's candidates are overwritten before
+				// they are moved.
+				for (unsigned worker = 1; worker != workers; ++worker)
+					std::swap_ranges(first + n * worker / workers, first + (n * worker / workers + k), first + k * worker);
+				std::partial_sort(first, middle, first + k * workers, comp);
+			}
+			else if (n / parallel_select_threshold >= 2 && threads >= 2)
+			{
+				parallel_nth_element(first, middle, last, comp, threads, std::is_default_constructible<value_type>());
+				pdqsort(first, middle, comp);
+			}
+			else
+				std::partial_sort(first, middle, last, comp);
+		}
+
+		inline unsigned hardware_threads()
+		{
+			return std::max(1u, std::thread::hardware_concurrency());
+		}
+	}
+
+	template<class RandomAccessRange>
+	void parallel_partial_sort(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type middle)
+	{
+		parallel_partial_sort(range, middle, std::less<>());
+	}
+
+	// As partial_sort, split across the hardware threads.
+	template<class RandomAccessRange, class Compare>
+	void parallel_partial_sort(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type middle, Compare comp)
+	{
+		detail::parallel_partial_sort(range_iterator<RandomAccessRange>(range, range.begin_pos()),
+									  range_iterator<RandomAccessRange>(range, middle),
+									  range_iterator<RandomAccessRange>(range, range.end_pos()),
+									  comp, detail::hardware_threads());
+	}
+
+	template<class RandomAccessRange>
+	void parallel_nth_element(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type nth)
+	{
+		parallel_nth_element(range, nth, std::less<>());
+	}
+
+	// As nth_element, split across the hardware threads.  Uses a buffer as large as the range.
+	template<class RandomAccessRange, class Compare>
+	void parallel_nth_element(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type nth, Compare comp)
+	{
+		typedef typename std::remove_cv<typename range_traits<RandomAccessRange>::value_type>::type value_type;
+		detail::parallel_nth_element(range_iterator<RandomAccessRange>(range, range.begin_pos()),
+									 range_iterator<RandomAccessRange>(range, nth),
+									 range_iterator<RandomAccessRange>(range, range.end_pos()),
+									 comp, detail::hardware_threads(), std::is_default_constructible<value_type>());
+	}
+
+	namespace detail
+	{
+		// Asks for the cache line holding p to be loaded, where the compiler offers a way to.
+		inline void prefetch(const void* p) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+			_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+			(void)p;
+#endif
+		}
+
+		// Binary search that halves the range with a conditional move rather than a branch, so
+		// that no step waits on a mispredicted comparison.  Both elements the next step may probe
+		// are prefetched, which for arrays beyond the cache keeps two loads in flight.
+		template <class T, class U, class Compare>
+		const T* branchless_lower_bound(const T* first, std::size_t n, const U& value, Compare comp)
+		{
+			if (n == 0)
+				return first;
+			while (n > 1)
+			{
+				auto half = n / 2;
+				auto next_half = (n - half) / 2;
+				prefetch(first + next_half);
+				prefetch(first + half + next_half);
+				first = comp(first[half], value) ? first + half : first;
+				n -= half;
+			}
+			return first + static_cast<std::size_t>(comp(*first, value));
+		}
+
+		template <class Range, class Compare>
+		struct is_branchless_search : std::integral_constant<bool,
+			is_contiguous_arithmetic<Range>::value && is_branchless_compare<Compare, typename range_traits<Range>::value_type>::value>
+		{
+		};
+
+		template<class ForwardRange, class T, class Compare>
+		typename range_traits<ForwardRange>::position_type lower_bound(const ForwardRange& range, const T& value, Compare comp, std::false_type /* is_branchless_search */)
+		{
+			return std::lower_bound(range_iterator<ForwardRange>(range, range.begin_pos()),
+									range_iterator<ForwardRange>(range, range.end_pos()),
+									value, comp).pos();
+		}
+
+		template<class ForwardRange, class T, class Compare>
+		typename range_traits<ForwardRange>::position_type lower_bound(const ForwardRange& range, const T& value, Compare comp, std::true_type /* is_branchless_search */)
+		{
+			auto p = range.begin_pos();
+			auto n = range.distance_pos(p, range.end_pos());
+			if (n != 0)
+			{
+				auto first = &range.at_pos(p);
+				range.advance_pos(p, branchless_lower_bound(first, static_cast<std::size_t>(n), value, comp) - first);
+			}
+			return p;
+		}
+	}
+
+	// Contiguous arithmetic values compared by < or > are searched without branches.
 	template<class ForwardRange, class T>
 	typename range_traits<ForwardRange>::position_type lower_bound(const ForwardRange& range, const T& value)
 	{
-		return std::lower_bound(range_iterator<ForwardRange>(range, range.begin_pos()),
-								range_iterator<ForwardRange>(range, range.end_pos()),
-								value).pos();
+		return detail::lower_bound(range, value, std::less<>(), detail::is_branchless_search<ForwardRange, std::less<>>());
 	}
 
 	template<class ForwardRange, class T, class Compare>
 	typename range_traits<ForwardRange>::position_type lower_bound(const ForwardRange& range, const T& value, Compare comp)
 	{
-		return std::lower_bound(range_iterator<ForwardRange>(range, range.begin_pos()),
-								range_iterator<ForwardRange>(range, range.end_pos()),
-								value, comp).pos();
+		return detail::lower_bound(range, value, comp, detail::is_branchless_search<ForwardRange, Compare>());
+	}
+
+	namespace detail
+	{
+		// Interpolation probes before interpolation_lower_bound falls back to binary search, and
+		// the length below which it does so anyway.
+		const int interpolation_probe_limit = 6;
+		const std::ptrdiff_t interpolation_min_length = 16;
+	}
+
+	// Estimates the position of value from the values at the ends of the part of the range still
+	// to be searched, which takes O(log log n) probes for evenly spread keys, then finishes with a
+	// binary search once the probe limit is reached, so that skewed keys cost at most a few
+	// probes more than a plain binary search.  Each probe costs a division, so this only beats
+	// lower_bound when most probes would miss the cache.  Floating point ranges that reach an
+	// infinity give no estimate, and are searched by binary search from there.
+	template<class RandomAccessRange, class T>
+	typename range_traits<RandomAccessRange>::position_type interpolation_lower_bound(const RandomAccessRange& range, const T& value)
+	{
+		static_assert(std::is_arithmetic<typename range_traits<RandomAccessRange>::value_type>::value,
+			"stdext::interpolation_lower_bound: range values must be arithmetic");
+		typedef range_iterator<RandomAccessRange> iterator;
+		iterator first(range, range.begin_pos());
+		typename range_traits<RandomAccessRange>::difference_type low = 0, high = length(range);
+		for (int probe = 0; probe != detail::interpolation_probe_limit && high - low > detail::interpolation_min_length; ++probe)
+		{
+			auto low_value = first[low], high_value = first[high - 1];
+			if (!(low_value < value))
+				return (first + low).pos();
+			if (high_value < value)
+				return (first + high).pos();
+			auto fraction = (static_cast<double>(value) - static_cast<double>(low_value)) / (static_cast<double>(high_value) - static_cast<double>(low_value));
+			if (!std::isfinite(fraction))
+				break;
+			auto guess = low + static_cast<decltype(low)>(fraction * static_cast<double>(high - 1 - low));
+			guess = std::min(std::max(guess, low), high - 1);
+			if (first[guess] < value)
+				low = guess + 1;
+			else
+				high = guess;
+		}
+		return stdext::lower_bound(subrange(range, (first + low).pos(), (first + high).pos()), value);
 	}
 
 	template<class ForwardRange, class T>
@@ -756,6 +2865,110 @@ namespace stdext
 								  value, comp);
 	}
 
+	namespace detail
+	{
+		// Searches run in step by search_index::lower_bound on a range of values.
+		const std::size_t search_batch_size = 16;
+	}
+
+	// search_index
+	template <class T, class Compare>
+	template <class ForwardRange>
+	search_index<T, Compare>::search_index(const ForwardRange& sorted, Compare comp)
+		: n(static_cast<size_type>(length(sorted))), tree(n + 1), ranks(n + 1), comp(std::move(comp))
+	{
+		// An in-order walk of the tree visits the nodes in sorted order.
+		auto p = sorted.begin_pos();
+		size_type rank = 0;
+		build(sorted, p, 1, rank);
+	}
+
+	template <class T, class Compare>
+	template <class Position, class ForwardRange>
+	void search_index<T, Compare>::build(const ForwardRange& sorted, Position& p, size_type k, size_type& rank)
+	{
+		if (k > n)
+			return;
+		build(sorted, p, 2 * k, rank);
+		tree[k] = sorted.at_pos(p);
+		sorted.increment_pos(p);
+		ranks[k] = rank++;
+		build(sorted, p, 2 * k + 1, rank);
+	}
+
+	// The sixteen descendants of node k four levels down are consecutive, in one or two lines.
+	template <class T, class Compare>
+	void search_index<T, Compare>::prefetch(size_type k) const noexcept
+	{
+		detail::prefetch(tree.data() + std::min(16 * k, n));
+	}
+
+	// A search ends past a leaf, at a node whose path turned right after the answer and then only
+	// right; dropping those trailing right turns and the last left one leads back to the answer.
+	template <class T, class Compare>
+	typename search_index<T, Compare>::size_type search_index<T, Compare>::finish(size_type k) const noexcept
+	{
+		while (k & 1)
+			k >>= 1;
+		k >>= 1;
+		return k == 0 ? n : ranks[k];
+	}
+
+	template <class T, class Compare>
+	template <class U>
+	typename search_index<T, Compare>::size_type search_index<T, Compare>::lower_bound(const U& value) const
+	{
+		size_type k = 1;
+		while (k <= n)
+		{
+			prefetch(k);
+			k = 2 * k + static_cast<size_type>(comp(tree[k], value));
+		}
+		return finish(k);
+	}
+
+	template <class T, class Compare>
+	template <class InputRange, class OutputIterator>
+	OutputIterator search_index<T, Compare>::lower_bound(const InputRange& values, OutputIterator result) const
+	{
+		typedef typename std::remove_cv<typename range_traits<InputRange>::value_type>::type value_type;
+		const auto batch = detail::search_batch_size;
+
+		// Every search passes through the same number of complete levels and then possibly one
+		// node of the incomplete last level.
+		size_type levels = 0;
+		while ((size_type(2) << levels) - 1 <= n)
+			++levels;
+
+		value_type keys[batch];
+		size_type nodes[batch];
+		auto p = values.begin_pos(), p_last = values.end_pos();
+		while (p != p_last)
+		{
+			std::size_t count = 0;
+			for (; count != batch && p != p_last; ++count, values.increment_pos(p))
+			{
+				keys[count] = values.at_pos(p);
+				nodes[count] = 1;
+			}
+			for (size_type level = 0; level != levels; ++level)
+			{
+				for (std::size_t i = 0; i != count; ++i)
+				{
+					prefetch(nodes[i]);
+					nodes[i] = 2 * nodes[i] + static_cast<size_type>(comp(tree[nodes[i]], keys[i]));
+				}
+			}
+			for (std::size_t i = 0; i != count; ++i)
+			{
+				if (nodes[i] <= n)
+					nodes[i] = 2 * nodes[i] + static_cast<size_type>(comp(tree[nodes[i]], keys[i]));
+				*result++ = finish(nodes[i]);
+			}
+		}
+		return result;
+	}
+
 	template<class InputRange1, class InputRange2, class OutputIterator>
 	OutputIterator merge(const InputRange1& range1, const InputRange2& range2, OutputIterator result)
 	{
@@ -793,23 +3006,112 @@ namespace stdext
 						   comp);
 	}
 
+	template<class BidirectionalRange>
+	void inplace_merge(const BidirectionalRange& range, typename range_traits<BidirectionalRange>::position_type middle, scratch_buffer& scratch)
+	{
+		inplace_merge(range, middle, std::less<>(), scratch);
+	}
+
+	// Merges through the shorter side's length of the scratch buffer if it fits, otherwise by
+	// rotations down to pieces that do; see detail::merge_adaptive.
+	template<class BidirectionalRange, class Compare>
+	void inplace_merge(const BidirectionalRange& range, typename range_traits<BidirectionalRange>::position_type middle, Compare comp, scratch_buffer& scratch)
+	{
+		typedef typename std::remove_cv<typename range_traits<BidirectionalRange>::value_type>::type value_type;
+		auto n = std::min(range.distance_pos(range.begin_pos(), middle), range.distance_pos(middle, range.end_pos()));
+		detail::scratch_array<value_type> buffer(scratch, static_cast<std::size_t>(n));
+		detail::merge_adaptive(range_iterator<BidirectionalRange>(range, range.begin_pos()),
+							   range_iterator<BidirectionalRange>(range, middle),
+							   range_iterator<BidirectionalRange>(range, range.end_pos()),
+							   buffer.data(), buffer.size(), comp);
+	}
+
+	namespace detail
+	{
+		// Galloping is used once one input is this many times longer than the other: each element
+		// of the shorter input then costs O(log gap) comparisons instead of a linear scan of the gap.
+		const std::ptrdiff_t gallop_ratio = 16;
+
+		template <class InputRange1, class InputRange2>
+		struct is_random_access_pair : std::integral_constant<bool,
+			is_random_access_range<InputRange1>::value && is_random_access_range<InputRange2>::value>
+		{
+		};
+
+		// Returns the first position at or after p whose element is not less than value, probing
+		// at exponentially growing distances before binary searching the last interval.
+		template <class RandomAccessRange, class T, class Compare>
+		typename range_traits<RandomAccessRange>::position_type
+			gallop_lower_bound(const RandomAccessRange& range, typename range_traits<RandomAccessRange>::position_type p, const T& value, Compare comp)
+		{
+			auto remaining = range.distance_pos(p, range.end_pos());
+			decltype(remaining) low = 0, high = 1;
+			for (;;)
+			{
+				if (high >= remaining)
+				{
+					high = remaining;
+					break;
+				}
+				auto probe = p;
+				if (!comp(range.at_pos(range.advance_pos(probe, high)), value))
+					break;
+				low = high + 1;
+				high *= 2;
+			}
+
+			auto first = p, last = p;
+			range.advance_pos(first, low);
+			range.advance_pos(last, high);
+			return std::lower_bound(range_iterator<RandomAccessRange>(range, first),
+									range_iterator<RandomAccessRange>(range, last),
+									value, comp).pos();
+		}
+
+		template<class InputRange1, class InputRange2, class Compare>
+		bool includes(const InputRange1& range1, const InputRange2& range2, Compare comp, std::false_type /* is_random_access_pair */)
+		{
+			return std::includes(range_iterator<InputRange1>(range1, range1.begin_pos()),
+								 range_iterator<InputRange1>(range1, range1.end_pos()),
+								 range_iterator<InputRange2>(range2, range2.begin_pos()),
+								 range_iterator<InputRange2>(range2, range2.end_pos()),
+								 comp);
+		}
+
+		template<class InputRange1, class InputRange2, class Compare>
+		bool includes(const InputRange1& range1, const InputRange2& range2, Compare comp, std::true_type /* is_random_access_pair */)
+		{
+			auto n1 = length(range1), n2 = length(range2);
+			if (n2 > n1)
+				return false;
+			if (n2 * gallop_ratio > n1)
+				return includes(range1, range2, comp, std::false_type());
+
+			auto p1 = range1.begin_pos(), last1 = range1.end_pos();
+			for (auto p2 = range2.begin_pos(), last2 = range2.end_pos(); p2 != last2; range2.increment_pos(p2))
+			{
+				auto&& value = range2.at_pos(p2);
+				p1 = gallop_lower_bound(range1, p1, value, comp);
+				if (p1 == last1 || comp(value, range1.at_pos(p1)))
+					return false;
+				range1.increment_pos(p1);
+			}
+			return true;
+		}
+	}
+
 	template<class InputRange1, class InputRange2>
 	bool includes(const InputRange1& range1, const InputRange2& range2)
 	{
-		return std::includes(range_iterator<InputRange1>(range1, range1.begin_pos()),
-							 range_iterator<InputRange1>(range1, range1.end_pos()),
-							 range_iterator<InputRange2>(range2, range2.begin_pos()),
-							 range_iterator<InputRange2>(range2, range2.end_pos()));
+		return includes(range1, range2, std::less<>());
 	}
 
+	// For random access ranges of very different lengths, each element of the shorter range is
+	// found by galloping through the longer one.
 	template<class InputRange1, class InputRange2, class Compare>
 	bool includes(const InputRange1& range1, const InputRange2& range2, Compare comp)
 	{
-		return std::includes(range_iterator<InputRange1>(range1, range1.begin_pos()),
-							 range_iterator<InputRange1>(range1, range1.end_pos()),
-							 range_iterator<InputRange2>(range2, range2.begin_pos()),
-							 range_iterator<InputRange2>(range2, range2.end_pos()),
-							 comp);
+		return detail::includes(range1, range2, comp, detail::is_random_access_pair<InputRange1, InputRange2>());
 	}
 
 	template<class InputRange1, class InputRange2, class OutputIterator>
@@ -832,24 +3134,200 @@ namespace stdext
 							  result, comp);
 	}
 
+	namespace detail
+	{
+		// Contiguous ranges of 32- or 64-bit integers ordered by operator < can be intersected by
+		// the branchless block kernel below.
+		template <class InputRange1, class InputRange2, class Compare>
+		struct is_integer_block_intersection : std::false_type
+		{
+		};
+
+		template <class T, class Compare>
+		struct is_integer_block_intersection<iterator_range<T*>, iterator_range<T*>, Compare> : std::integral_constant<bool,
+			std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)
+			&& (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<typename std::remove_cv<T>::type>>::value)>
+		{
+		};
+
+		template<class InputRange1, class InputRange2, class OutputIterator, class Compare>
+		OutputIterator merge_intersection(const InputRange1& range1, const InputRange2& range2, OutputIterator result, Compare comp, std::false_type)
+		{
+			return std::set_intersection(range_iterator<InputRange1>(range1, range1.begin_pos()),
+										 range_iterator<InputRange1>(range1, range1.end_pos()),
+										 range_iterator<InputRange2>(range2, range2.begin_pos()),
+										 range_iterator<InputRange2>(range2, range2.end_pos()),
+										 result, comp);
+		}
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		// A bit for each of the four values at a that equals any of the four at b.
+		template <class T>
+		typename std::enable_if<sizeof(T) == 4, int>::type block_matches(const T* a, const T* b) noexcept
+		{
+			auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+			auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+			auto m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+								  _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4e)), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+			return _mm_movemask_ps(_mm_castsi128_ps(m));
+		}
+#endif
+
+#if defined(__AVX2__)
+		template <class T>
+		typename std::enable_if<sizeof(T) == 8, int>::type block_matches(const T* a, const T* b) noexcept
+		{
+			auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+			auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+			auto m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi64(va, vb), _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x39))),
+									 _mm256_or_si256(_mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x4e)), _mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(vb, 0x93))));
+			return _mm256_movemask_pd(_mm256_castsi256_pd(m));
+		}
+#endif
+
+		// Integers for which the target has a block_matches: 32-bit ones with SSE2, 64-bit ones
+		// with AVX2.
+		template <class T, class Enable = void>
+		struct has_block_matches : std::false_type
+		{
+		};
+
+		template <class T>
+		struct has_block_matches<T, decltype((void)block_matches(std::declval<const T*>(), std::declval<const T*>()))> : std::true_type
+		{
+		};
+
+		template <class Pointer, class T, class OutputIterator>
+		void block_intersection(Pointer&, Pointer, Pointer&, Pointer, T*, std::size_t, OutputIterator&, std::false_type /* has_block_matches */)
+		{
+		}
+
+		// Compares four values of each range with all four of the other's at once, then moves past
+		// whichever block ends lower, or both.  A value is output once for each block of the other
+		// range it matches in, so this needs ranges without repeated values; checking that costs a
+		// seventh of the intersection, which the kernel repays several times over.  The ends that
+		// do not fill a block are left to the caller.
+		template <class Pointer, class T, class OutputIterator>
+		void block_intersection(Pointer& p1, Pointer last1, Pointer& p2, Pointer last2, T* block, std::size_t block_size, OutputIterator& result, std::true_type /* has_block_matches */)
+		{
+			auto repeats = [](const T& a, const T& b) { return !(a < b); };
+			if (std::adjacent_find(p1, last1, repeats) != last1 || std::adjacent_find(p2, last2, repeats) != last2)
+				return;
+
+			std::size_t n = 0;
+			while (last1 - p1 >= 4 && last2 - p2 >= 4)
+			{
+				auto matches = block_matches(p1, p2);
+				for (int i = 0; i != 4; ++i)
+				{
+					block[n] = p1[i];
+					n += (matches >> i) & 1;
+				}
+				auto max1 = p1[3], max2 = p2[3];
+				p1 += (max1 <= max2) * 4;
+				p2 += (max2 <= max1) * 4;
+				if (n > block_size - 4)
+				{
+					result = std::copy(block, block + n, result);
+					n = 0;
+				}
+			}
+			result = std::copy(block, block + n, result);
+		}
+
+		// Where the target allows, blocks of both ranges are first compared all pairs at once; see
+		// block_intersection.  The merge loop that finishes the ranges, or does all the work, is
+		// written without data-dependent branches: every step stores the smaller value into a
+		// local block and advances the output cursor only when the two values matched, so the loop
+		// compiles to conditional moves and the block is flushed to the (arbitrary) output
+		// iterator in bulk.
+		template<class InputRange1, class InputRange2, class OutputIterator, class Compare>
+		OutputIterator merge_intersection(const InputRange1& range1, const InputRange2& range2, OutputIterator result, Compare, std::true_type)
+		{
+			typedef typename std::remove_cv<typename range_traits<InputRange1>::value_type>::type value_type;
+			const std::size_t block_size = 256;
+			value_type block[block_size];
+
+			auto p1 = range1.begin_pos(), last1 = range1.end_pos();
+			auto p2 = range2.begin_pos(), last2 = range2.end_pos();
+			block_intersection(p1, last1, p2, last2, block, block_size, result, has_block_matches<value_type>());
+			while (p1 != last1 && p2 != last2)
+			{
+				std::size_t n = 0;
+				for (auto steps = block_size; steps != 0 && p1 != last1 && p2 != last2; --steps)
+				{
+					auto a = *p1, b = *p2;
+					block[n] = a;
+					n += a == b;
+					p1 += a <= b;
+					p2 += b <= a;
+				}
+				result = std::copy(block, block + n, result);
+			}
+			return result;
+		}
+
+		template<class InputRange1, class InputRange2, class OutputIterator, class Compare>
+		OutputIterator set_intersection(const InputRange1& range1, const InputRange2& range2, OutputIterator result, Compare comp, std::false_type /* is_random_access_pair */)
+		{
+			return merge_intersection(range1, range2, result, comp, std::false_type());
+		}
+
+		template<class InputRange1, class InputRange2, class OutputIterator, class Compare>
+		OutputIterator set_intersection(const InputRange1& range1, const InputRange2& range2, OutputIterator result, Compare comp, std::true_type /* is_random_access_pair */)
+		{
+			auto n1 = length(range1), n2 = length(range2);
+			if (n1 * gallop_ratio <= n2)
+			{
+				auto p2 = range2.begin_pos(), last2 = range2.end_pos();
+				for (auto p1 = range1.begin_pos(), last1 = range1.end_pos(); p1 != last1 && p2 != last2; range1.increment_pos(p1))
+				{
+					auto&& value = range1.at_pos(p1);
+					p2 = gallop_lower_bound(range2, p2, value, comp);
+					if (p2 != last2 && !comp(value, range2.at_pos(p2)))
+					{
+						*result = value;
+						++result;
+						range2.increment_pos(p2);
+					}
+				}
+				return result;
+			}
+			else if (n2 * gallop_ratio <= n1)
+			{
+				auto p1 = range1.begin_pos(), last1 = range1.end_pos();
+				for (auto p2 = range2.begin_pos(), last2 = range2.end_pos(); p1 != last1 && p2 != last2; range2.increment_pos(p2))
+				{
+					auto&& value = range2.at_pos(p2);
+					p1 = gallop_lower_bound(range1, p1, value, comp);
+					if (p1 != last1 && !comp(value, range1.at_pos(p1)))
+					{
+						*result = range1.at_pos(p1);
+						++result;
+						range1.increment_pos(p1);
+					}
+				}
+				return result;
+			}
+			return merge_intersection(range1, range2, result, comp, is_integer_block_intersection<InputRange1, InputRange2, Compare>());
+		}
+	}
+
 	template<class InputRange1, class InputRange2, class OutputIterator>
 	OutputIterator set_intersection(const InputRange1& range1, const InputRange2& range2, OutputIterator result)
 	{
-		return std::set_intersection(range_iterator<InputRange1>(range1, range1.begin_pos()),
-									 range_iterator<InputRange1>(range1, range1.end_pos()),
-									 range_iterator<InputRange2>(range2, range2.begin_pos()),
-									 range_iterator<InputRange2>(range2, range2.end_pos()),
-									 result);
+		return set_intersection(range1, range2, result, std::less<>());
 	}
 
+	// The kernel is chosen from the lengths of the inputs: galloping when one random access range
+	// is much longer than the other, a branchless block merge for contiguous integers, which
+	// compares whole blocks with SSE2 or AVX2 when neither range repeats a value, and a linear
+	// merge otherwise.  As with std::set_intersection, matched elements are copied from
+	// range1.
 	template<class InputRange1, class InputRange2, class OutputIterator, class Compare>
 	OutputIterator set_intersection(const InputRange1& range1, const InputRange2& range2, OutputIterator result, Compare comp)
 	{
-		return std::set_intersection(range_iterator<InputRange1>(range1, range1.begin_pos()),
-									 range_iterator<InputRange1>(range1, range1.end_pos()),
-									 range_iterator<InputRange2>(range2, range2.begin_pos()),
-									 range_iterator<InputRange2>(range2, range2.end_pos()),
-									 result, comp);
+		return detail::set_intersection(range1, range2, result, comp, detail::is_random_access_pair<InputRange1, InputRange2>());
 	}
 
 	template<class InputRange1, class InputRange2, class OutputIterator>
@@ -982,6 +3460,193 @@ namespace stdext
 								  comp).pos();
 	}
 
+	namespace detail
+	{
+		// d-ary heaps keep the Arity children of element i at Arity * i + 1 onwards.  A wider node
+		// halves (for Arity 4) or thirds (for Arity 8) the depth of the heap, and its children share
+		// one or two cache lines, so a sift down touches far fewer lines than in a binary heap for
+		// the price of a few more comparisons per level.
+		template <std::size_t Arity, class Iterator, class Compare>
+		void dary_sift_up(Iterator first, std::ptrdiff_t hole, Compare& comp)
+		{
+			typename std::iterator_traits<Iterator>::value_type value = std::move(first[hole]);
+			while (hole > 0)
+			{
+				auto parent = (hole - 1) / static_cast<std::ptrdiff_t>(Arity);
+				if (!comp(first[parent], value))
+					break;
+				first[hole] = std::move(first[parent]);
+				hole = parent;
+			}
+			first[hole] = std::move(value);
+		}
+
+		template <std::size_t Arity, class Iterator, class T, class Compare>
+		void dary_sift_down(Iterator first, std::ptrdiff_t n, std::ptrdiff_t hole, T&& value, Compare& comp)
+		{
+			const auto arity = static_cast<std::ptrdiff_t>(Arity);
+			for (;;)
+			{
+				auto child = arity * hole + 1;
+				if (child >= n)
+					break;
+				auto best = child;
+				if (child + arity <= n)
+				{
+					for (auto i = child + 1; i != child + arity; ++i)
+						best = comp(first[best], first[i]) ? i : best;
+				}
+				else
+				{
+					for (auto i = child + 1; i < n; ++i)
+						best = comp(first[best], first[i]) ? i : best;
+				}
+				if (!comp(value, first[best]))
+					break;
+				first[hole] = std::move(first[best]);
+				hole = best;
+			}
+			first[hole] = std::forward<T>(value);
+		}
+
+		template <std::size_t Arity, class Iterator, class Compare>
+		void pop_dary_heap(Iterator first, std::ptrdiff_t n, Compare& comp)
+		{
+			if (n < 2)
+				return;
+			typename std::iterator_traits<Iterator>::value_type value = std::move(first[n - 1]);
+			first[n - 1] = std::move(first[0]);
+			dary_sift_down<Arity>(first, n - 1, 0, std::move(value), comp);
+		}
+
+		template <std::size_t Arity, class Iterator, class Compare>
+		void make_dary_heap(Iterator first, std::ptrdiff_t n, Compare& comp)
+		{
+			typedef typename std::iterator_traits<Iterator>::value_type value_type;
+			for (auto i = (n - 2) / static_cast<std::ptrdiff_t>(Arity) + 1; i-- > 0; )
+			{
+				value_type value = std::move(first[i]);
+				dary_sift_down<Arity>(first, n, i, std::move(value), comp);
+			}
+		}
+	}
+
+	template<std::size_t Arity, class RandomAccessRange>
+	void push_dary_heap(const RandomAccessRange& range)
+	{
+		push_dary_heap<Arity>(range, std::less<>());
+	}
+
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	void push_dary_heap(const RandomAccessRange& range, Compare comp)
+	{
+		auto n = length(range);
+		if (n > 1)
+			detail::dary_sift_up<Arity>(range_iterator<RandomAccessRange>(range, range.begin_pos()), n - 1, comp);
+	}
+
+	template<std::size_t Arity, class RandomAccessRange>
+	void pop_dary_heap(const RandomAccessRange& range)
+	{
+		pop_dary_heap<Arity>(range, std::less<>());
+	}
+
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	void pop_dary_heap(const RandomAccessRange& range, Compare comp)
+	{
+		detail::pop_dary_heap<Arity>(range_iterator<RandomAccessRange>(range, range.begin_pos()), length(range), comp);
+	}
+
+	template<std::size_t Arity, class RandomAccessRange>
+	void make_dary_heap(const RandomAccessRange& range)
+	{
+		make_dary_heap<Arity>(range, std::less<>());
+	}
+
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	void make_dary_heap(const RandomAccessRange& range, Compare comp)
+	{
+		auto n = length(range);
+		if (n > 1)
+			detail::make_dary_heap<Arity>(range_iterator<RandomAccessRange>(range, range.begin_pos()), n, comp);
+	}
+
+	template<std::size_t Arity, class RandomAccessRange>
+	void sort_dary_heap(const RandomAccessRange& range)
+	{
+		sort_dary_heap<Arity>(range, std::less<>());
+	}
+
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	void sort_dary_heap(const RandomAccessRange& range, Compare comp)
+	{
+		range_iterator<RandomAccessRange> first(range, range.begin_pos());
+		for (auto n = length(range); n > 1; --n)
+			detail::pop_dary_heap<Arity>(first, n, comp);
+	}
+
+	template<std::size_t Arity, class RandomAccessRange>
+	bool is_dary_heap(const RandomAccessRange& range)
+	{
+		return is_dary_heap<Arity>(range, std::less<>());
+	}
+
+	template<std::size_t Arity, class RandomAccessRange, class Compare>
+	bool is_dary_heap(const RandomAccessRange& range, Compare comp)
+	{
+		range_iterator<RandomAccessRange> first(range, range.begin_pos());
+		for (decltype(length(range)) i = 1, n = length(range); i < n; ++i)
+		{
+			if (comp(first[(i - 1) / static_cast<decltype(i)>(Arity)], first[i]))
+				return false;
+		}
+		return true;
+	}
+
+	// heap_queue
+	template <class T, std::size_t Arity, class Compare>
+	template <class InputRange>
+	void heap_queue<T, Arity, Compare>::push_range(const InputRange& range)
+	{
+		auto old_size = static_cast<std::ptrdiff_t>(values.size());
+		for (auto p = range.begin_pos(), p_last = range.end_pos(); p != p_last; range.increment_pos(p))
+			values.push_back(range.at_pos(p));
+		auto n = static_cast<std::ptrdiff_t>(values.size()), added = n - old_size;
+
+		// Sifting each new element up costs up to one comparison per level; rebuilding the whole
+		// heap costs about as many comparisons as there are elements.
+		std::ptrdiff_t depth = 1;
+		for (auto level = n; level > static_cast<std::ptrdiff_t>(Arity); level /= static_cast<std::ptrdiff_t>(Arity))
+			++depth;
+		if (added * depth > n)
+			detail::make_dary_heap<Arity>(values.begin(), n, comp);
+		else
+		{
+			for (auto i = old_size; i != n; ++i)
+				detail::dary_sift_up<Arity>(values.begin(), i, comp);
+		}
+	}
+
+	template <class T, std::size_t Arity, class Compare>
+	void heap_queue<T, Arity, Compare>::pop()
+	{
+		detail::pop_dary_heap<Arity>(values.begin(), static_cast<std::ptrdiff_t>(values.size()), comp);
+		values.pop_back();
+	}
+
+	template <class T, std::size_t Arity, class Compare>
+	template <class OutputIterator>
+	OutputIterator heap_queue<T, Arity, Compare>::pop_n(size_type n, OutputIterator result)
+	{
+		for (; n != 0 && !values.empty(); --n)
+		{
+			detail::pop_dary_heap<Arity>(values.begin(), static_cast<std::ptrdiff_t>(values.size()), comp);
+			*result++ = std::move(values.back());
+			values.pop_back();
+		}
+		return result;
+	}
+
 	template<class ForwardRange>
 	typename range_traits<ForwardRange>::position_type min_element(const ForwardRange& range)
 	{
@@ -997,6 +3662,46 @@ namespace stdext
 								comp).pos();
 	}
 
+	namespace detail
+	{
+		// Tracks the index of the minimum rather than a pointer to it so that each step compiles
+		// to a conditional move.
+		template<class T, class Compare, std::size_t... I>
+		T* unrolled_min_element(T* first, Compare comp, std::index_sequence<I...>)
+		{
+			std::size_t min = 0;
+			int expand[] = { 0, (min = comp(first[I + 1], first[min]) ? I + 1 : min, 0)... };
+			(void)expand;
+			return first + min;
+		}
+
+		template<class T, std::size_t N, class Compare>
+		T* min_element(const fixed_range<T, N>& range, Compare comp, std::false_type /* is_fixed_unrolled */)
+		{
+			return std::min_element(range.begin_pos(), range.end_pos(), comp);
+		}
+
+		template<class T, std::size_t N, class Compare>
+		T* min_element(const fixed_range<T, N>& range, Compare comp, std::true_type /* is_fixed_unrolled */)
+		{
+			if (!is_full(range))
+				return detail::min_element(range, comp, std::false_type());
+			return unrolled_min_element(range.begin_pos(), comp, std::make_index_sequence<N - 1>());
+		}
+	}
+
+	template<class T, std::size_t N>
+	T* min_element(const fixed_range<T, N>& range)
+	{
+		return detail::min_element(range, std::less<>(), detail::is_fixed_unrolled<N>());
+	}
+
+	template<class T, std::size_t N, class Compare>
+	T* min_element(const fixed_range<T, N>& range, Compare comp)
+	{
+		return detail::min_element(range, comp, detail::is_fixed_unrolled<N>());
+	}
+
 	template<class ForwardRange>
 	typename range_traits<ForwardRange>::position_type max_element(const ForwardRange& range)
 	{
@@ -69,6 +69,8 @@
 // by [first_pos, last_pos) as long as p still refers to an element in the underlying sequence (or,
 // in the case of end_pos(p), one element beyond the last element in the underlying sequence).
 
+#include <array>
+#include <cstddef>
 #include <iterator>
 #include <utility>
 
@@ -121,6 +123,8 @@ namespace stdext
 	// Range classes
 	template <class Iterator>
 	class iterator_range;
+	template <class T, std::size_t N>
+	class fixed_range;
 
 	// Range iterators
 	template <class Range>
@@ -178,6 +182,12 @@ namespace stdext
 	iterator_range<Iterator> make_range(Iterator first, Iterator last);
 	template <class C>
 	iterator_range<typename detail::iterator_type<typename std::remove_reference<C>::type>::type> make_range(C&& c);
+	template <class T, std::size_t N>
+	fixed_range<T, N> make_fixed_range(T (&a)[N]);
+	template <class T, std::size_t N>
+	fixed_range<T, N> make_fixed_range(std::array<T, N>& a);
+	template <class T, std::size_t N>
+	fixed_range<const T, N> make_fixed_range(const std::array<T, N>& a);
 
 	template <class Range>
 	Range range_before(Range range, typename range_traits<Range>::position_type p);
@@ -350,6 +360,19 @@ namespace stdext
 		Iterator first, last;
 	};
 
+	// An iterator_range over an array whose length is known at compile time.  Algorithms with
+	// overloads for fixed_range unroll their loops completely while the range still spans all N
+	// elements; once narrowed, it is treated as any other iterator_range.
+	template <class T, std::size_t N>
+	class fixed_range : public iterator_range<T*>
+	{
+	public:
+		static const std::size_t extent = N;
+
+	public:
+		explicit fixed_range(T* first) : iterator_range<T*>(first, first + N) { }
+	};
+
 	namespace detail
 	{
 		std::output_iterator_tag        to_iterator_category(output_range_tag);
@@ -464,8 +487,8 @@ namespace stdext
 		bool operator < (const range_iterator_base<Iterator, Range, IteratorCategory, std::random_access_iterator_tag>& a,
 						 const range_iterator_base<Iterator, Range, IteratorCategory, std::random_access_iterator_tag>& b)
 		{
-			const auto& ai = static_cast<Iterator>(a);
-			const auto& bi = static_cast<Iterator>(b);
+			const auto& ai = static_cast<const Iterator&>(a);
+			const auto& bi = static_cast<const Iterator&>(b);
 			return ai.pos() < bi.pos();
 		}
 
@@ -514,9 +537,14 @@ namespace stdext
 		(const detail::range_iterator_base<range_iterator, Range, iterator_category, std::input_iterator_tag>& a,
 		 const detail::range_iterator_base<range_iterator, Range, iterator_category, std::input_iterator_tag>& b);
 		friend bool detail::operator < <range_iterator, Range, iterator_category>
+		(const detail::range_iterator_base<range_iterator, Range, iterator_category, std::random_access_iterator_tag>& a,
+		 const detail::range_iterator_base<range_iterator, Range, iterator_category, std::random_access_iterator_tag>& b);
+		friend typename detail::range_iterator_base<range_iterator, Range, iterator_category, std::random_access_iterator_tag>::difference_type detail::operator - <range_iterator, Range, iterator_category>
 		(const detail::range_iterator_base<range_iterator, Range, iterator_category, std::random_access_iterator_tag>& a,
 		 const detail::range_iterator_base<range_iterator, Range, iterator_category, std::random_access_iterator_tag>& b);
 		friend struct detail::range_iterator_base<range_iterator, Range, iterator_category, std::input_iterator_tag>;
+		friend struct detail::range_iterator_base<range_iterator, Range, iterator_category, std::bidirectional_iterator_tag>;
+		friend struct detail::range_iterator_base<range_iterator, Range, iterator_category, std::random_access_iterator_tag>;
 		const range_type* range;
 		position_type p;
 	};
@@ -532,6 +560,7 @@ namespace stdext
 			IteratorCategory,
 			typename range_traits<Range>::value_type,
 			typename range_traits<Range>::difference_type,
+			typename std::remove_reference<typename range_traits<Range>::reference>::type*,
 			typename range_traits<Range>::reference>
 		{
 			typedef typename std::iterator_traits<iterator_range_iterator_base>::reference reference;
@@ -20,13 +20,13 @@ namespace stdext
 	template <class Range>
 	range_iterator<Range> begin(const Range& r)
 	{
-		return range_iterator<Range>(&r, r.begin_pos());
+		return range_iterator<Range>(r, r.begin_pos());
 	}
 
 	template <class Range>
 	range_iterator<Range> end(const Range& r)
 	{
-		return range_iterator<Range>(&r, r.end_pos());
+		return range_iterator<Range>(r, r.end_pos());
 	}
 
 	template <class Range>
@@ -120,6 +120,28 @@ namespace stdext
 		return make_range(begin(std::forward<C>(c)), end(std::forward<C>(c)));
 	}
 
+	// fixed_range
+	template <class T, std::size_t N>
+	const std::size_t fixed_range<T, N>::extent;
+
+	template <class T, std::size_t N>
+	fixed_range<T, N> make_fixed_range(T (&a)[N])
+	{
+		return fixed_range<T, N>(a);
+	}
+
+	template <class T, std::size_t N>
+	fixed_range<T, N> make_fixed_range(std::array<T, N>& a)
+	{
+		return fixed_range<T, N>(a.data());
+	}
+
+	template <class T, std::size_t N>
+	fixed_range<const T, N> make_fixed_range(const std::array<T, N>& a)
+	{
+		return fixed_range<const T, N>(a.data());
+	}
+
 	template <class Range>
 	Range range_before(Range range, typename range_traits<Range>::position_type p)
 	{
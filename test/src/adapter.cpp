@@ -6,7 +6,13 @@
 #include <boost/test/unit_test.hpp>
 
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <forward_list>
 #include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 
 #define RANGE(c) begin(c), end(c)
@@ -189,6 +195,40 @@ void unique_if_test(Iterator first, Iterator last)
 }
 DEFINE_INPUT_TESTS(unique_if_test)
 
+template <typename Iterator>
+void distinct_test(Iterator first, Iterator last)
+{
+	int values[] = { 3, 1, 3, 2, 1, 4, 2, 3, 0, 4 };
+	int distinct_values[] = { 3, 1, 2, 4, 0 };
+	BOOST_CHECK(equal(make_range(values) >> distinct(), make_range(distinct_values)));
+	BOOST_CHECK(equal(make_range(first, last) >> distinct(), make_range(first, last)));
+	BOOST_CHECK(stdext::empty(make_range(first, first) >> distinct()));
+}
+DEFINE_INPUT_TESTS(distinct_test)
+
+BOOST_AUTO_TEST_CASE(distinct_scratch_test)
+{
+	std::vector<std::uint64_t> ids(20000);
+	for (std::size_t i = 0; i != ids.size(); ++i)
+		ids[i] = (i * 7919 % 5003) << 20;
+	std::vector<std::uint64_t> expected;
+	for (auto id : ids)
+	{
+		if (std::find(expected.begin(), expected.end(), id) == expected.end())
+			expected.push_back(id);
+	}
+
+	static unsigned char memory[16 * 1024];
+	scratch_buffer scratch(memory, sizeof(memory));
+	auto seen = make_range(ids.data(), ids.data() + ids.size()) >> distinct(scratch);
+	std::vector<std::uint64_t> result(stdext::begin(seen), stdext::end(seen));
+	BOOST_CHECK(result == expected);
+
+	std::vector<std::string> words = { "fig", "apple", "fig", "kiwi", "apple", "fig" };
+	std::string distinct_words[] = { "fig", "apple", "kiwi" };
+	BOOST_CHECK(equal(make_range(words) >> distinct(), make_range(distinct_words)));
+}
+
 template <typename Iterator>
 void reverse_test(Iterator first, Iterator last)
 {
@@ -233,4 +273,650 @@ void partition_if_test(Iterator first, Iterator last)
 	int values[] = { 0, 2, 4, 6, 8, 1, 3, 5, 7, 9 };
 	BOOST_CHECK(equal(range, make_range(values)));
 }
-DEFINE_FORWARD_TESTS(partition_if_test)
\ No newline at end of file
+DEFINE_FORWARD_TESTS(partition_if_test)
+
+static vector<string> tokens(const split_range& range)
+{
+	vector<string> result;
+	for (auto p = range.begin_pos(), p_last = range.end_pos(); p != p_last; range.increment_pos(p))
+	{
+		auto token = range.at_pos(p);
+		result.emplace_back(token.begin(), token.end());
+	}
+	return result;
+}
+
+BOOST_AUTO_TEST_CASE(split_test)
+{
+	const char text[] = "alpha,beta,,gamma,";
+	auto range = make_range(text, text + sizeof(text) - 1) >> split(',');
+	vector<string> expected = { "alpha", "beta", "", "gamma", "" };
+	BOOST_CHECK(tokens(range) == expected);
+	BOOST_CHECK_EQUAL(length(range), 5);
+
+	const char* empty = "";
+	BOOST_CHECK(stdext::empty(make_range(empty, empty) >> split(',')));
+}
+
+BOOST_AUTO_TEST_CASE(lines_test)
+{
+	const char text[] = "first\r\nsecond\n\nfourth\n";
+	auto range = make_range(text, text + sizeof(text) - 1) >> lines();
+	vector<string> expected = { "first", "second", "", "fourth" };
+	BOOST_CHECK(tokens(range) == expected);
+
+	auto selected = make_range(text, text + sizeof(text) - 1) >> lines() >> select_if([](const iterator_range<const char*>& line) { return !stdext::empty(line); });
+	int count = 0;
+	for (auto p = selected.begin_pos(), p_last = selected.end_pos(); p != p_last; selected.increment_pos(p))
+		++count;
+	BOOST_CHECK_EQUAL(count, 3);
+}
+
+namespace record_test
+{
+	// Trivially copyable, but not default constructible.
+	struct trade
+	{
+		trade(uint32_t id, uint16_t q0, uint16_t q1) : id(id), qty{ q0, q1 } { }
+		uint32_t id;
+		uint16_t qty[2];
+	};
+
+	void swap_record_bytes(trade& t) noexcept
+	{
+		using stdext::swap_record_bytes;
+		swap_record_bytes(t.id);
+		swap_record_bytes(t.qty);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(record_view_test)
+{
+	// Offset the records by one byte so that none of them is suitably aligned.
+	unsigned char bytes[1 + 4 * sizeof(uint32_t) + 2] = { };
+	uint32_t values[] = { 1, 0x01020304, 0xdeadbeef, 42 };
+	memcpy(bytes + 1, values, sizeof(values));
+
+	auto records = record_view<uint32_t>(make_range(bytes + 1, end(bytes)));
+	BOOST_CHECK_EQUAL(length(records), 4);
+	BOOST_CHECK(equal(records, make_range(values)));
+	auto p = records.begin_pos();
+	records.advance_pos(p, 2);
+	BOOST_CHECK_EQUAL(records.at_pos(p), 0xdeadbeef);
+
+	auto doubled = record_view<uint32_t>(make_range(bytes + 1, end(bytes))) >> transform([](uint32_t n) { return n * 2; });
+	BOOST_CHECK_EQUAL(back(doubled), 84u);
+
+	const byte_order swapped = byte_order::native == byte_order::little ? byte_order::big : byte_order::little;
+	auto swapped_records = record_view<uint32_t, swapped>(make_range(bytes + 1, end(bytes)));
+	p = swapped_records.begin_pos();
+	swapped_records.increment_pos(p);
+	BOOST_CHECK_EQUAL(swapped_records.at_pos(p), 0x04030201u);
+
+	record_test::trade trades[] = { { 0x01020304, 0x0506, 0x0708 }, { 7, 8, 9 } };
+	unsigned char trade_bytes[1 + sizeof(trades)];
+	memcpy(trade_bytes + 1, trades, sizeof(trades));
+	auto native_trades = record_view<record_test::trade>(make_range(trade_bytes + 1, end(trade_bytes)));
+	BOOST_CHECK_EQUAL(length(native_trades), 2);
+	BOOST_CHECK_EQUAL(back(native_trades).qty[1], 9);
+	auto swapped_trades = record_view<record_test::trade, swapped>(make_range(trade_bytes + 1, end(trade_bytes)));
+	auto t = front(swapped_trades);
+	BOOST_CHECK_EQUAL(t.id, 0x04030201u);
+	BOOST_CHECK_EQUAL(t.qty[0], 0x0605);
+	BOOST_CHECK_EQUAL(t.qty[1], 0x0807);
+}
+
+template <typename Iterator>
+void stride_test(Iterator first, Iterator last)
+{
+	auto range = make_range(first, last) >> stride(3);
+	int values[] = { 0, 3, 6, 9 };
+	BOOST_CHECK(equal(range, make_range(values)));
+	BOOST_CHECK_THROW(make_range(first, last) >> stride(0), domain_error);
+	BOOST_CHECK_THROW(make_range(first, last) >> stride(-2), domain_error);
+}
+DEFINE_INPUT_TESTS(stride_test)
+
+template <typename Iterator>
+void stride_reverse_test(Iterator first, Iterator last)
+{
+	auto range = make_range(first, last) >> stride(4) >> reverse();
+	int values[] = { 8, 4, 0 };
+	BOOST_CHECK(equal(range, make_range(values)));
+}
+DEFINE_BIDIRECTIONAL_TESTS(stride_reverse_test)
+
+template <typename Iterator>
+void stride_random_access_test(Iterator first, Iterator last)
+{
+	auto range = make_range(first, last) >> stride(4);
+	BOOST_CHECK_EQUAL(length(range), 3);
+	auto p = range.begin_pos();
+	range.advance_pos(p, 2);
+	BOOST_CHECK_EQUAL(range.at_pos(p), 8);
+	range.advance_pos(p, 1);
+	BOOST_CHECK(p == range.end_pos());
+	range.advance_pos(p, -2);
+	BOOST_CHECK_EQUAL(range.at_pos(p), 4);
+	BOOST_CHECK_EQUAL(range.distance_pos(p, range.end_pos()), 2);
+}
+DEFINE_RANDOM_ACCESS_TESTS(stride_random_access_test)
+
+template <typename Iterator>
+void zip_test(Iterator first, Iterator last)
+{
+	const char* names[] = { "zero", "one", "two" };
+	auto range = zip(make_range(first, last), make_range(names));
+	int value = 0;
+	for (auto p = range.begin_pos(), p_last = range.end_pos(); p != p_last; range.increment_pos(p))
+	{
+		auto element = range.at_pos(p);
+		BOOST_CHECK_EQUAL(get<0>(element), value);
+		BOOST_CHECK_EQUAL(get<1>(element), names[value]);
+		++value;
+	}
+
+	BOOST_CHECK_EQUAL(value, 3);
+}
+DEFINE_INPUT_TESTS(zip_test)
+
+template <typename Iterator>
+void zip_bidirectional_test(Iterator first, Iterator last)
+{
+	const char* names[] = { "zero", "one", "two" };
+	auto range = zip(make_range(first, last), make_range(names));
+	auto p = range.end_pos();
+	range.decrement_pos(p);
+	BOOST_CHECK_EQUAL(get<0>(range.at_pos(p)), 2);
+	BOOST_CHECK_EQUAL(get<1>(range.at_pos(p)), "two");
+
+	auto q = range.begin_pos();
+	range.increment_pos(q);
+	range.increment_pos(q);
+	BOOST_CHECK(p == q);
+	range.decrement_pos(q);
+	BOOST_CHECK(p != q);
+	BOOST_CHECK_EQUAL(length(range), 3);
+}
+DEFINE_BIDIRECTIONAL_TESTS(zip_bidirectional_test)
+
+BOOST_AUTO_TEST_CASE(zip_empty_test)
+{
+	forward_list<int> numbers = { 1, 2, 3 };
+	vector<int> empty;
+	auto range = zip(make_range(numbers), make_range(empty));
+	BOOST_CHECK(range.begin_pos() == range.end_pos());
+	auto shorter = zip(make_range(numbers), make_range(numbers.begin(), next(numbers.begin(), 2)));
+	auto p = shorter.begin_pos();
+	shorter.increment_pos(p);
+	shorter.increment_pos(p);
+	BOOST_CHECK(p == shorter.end_pos());
+}
+
+BOOST_AUTO_TEST_CASE(zip_sort_test)
+{
+	vector<int> keys = { 3, 1, 4, 1, 5, 9, 2, 6 };
+	vector<string> names = { "c", "a", "d", "b", "e", "h", "f", "g" };
+	auto range = zip(make_range(keys), make_range(names));
+	BOOST_CHECK_EQUAL(length(range), 8);
+
+	stdext::sort(range);
+	vector<int> sorted_keys = { 1, 1, 2, 3, 4, 5, 6, 9 };
+	vector<string> sorted_names = { "a", "b", "f", "c", "d", "e", "g", "h" };
+	BOOST_CHECK(keys == sorted_keys);
+	BOOST_CHECK(names == sorted_names);
+
+	stdext::sort(range, [](const auto& a, const auto& b) { return get<1>(a) > get<1>(b); });
+	BOOST_CHECK_EQUAL(names.front(), "h");
+	BOOST_CHECK_EQUAL(keys.front(), 9);
+}
+
+template <typename Iterator>
+void chunk_test(Iterator first, Iterator last)
+{
+	auto range = make_range(first, last) >> chunk(4);
+	int value = 0, chunks = 0;
+	for (auto p = range.begin_pos(), p_last = range.end_pos(); p != p_last; range.increment_pos(p))
+	{
+		auto chunk = range.at_pos(p);
+		BOOST_CHECK_EQUAL(length(chunk), chunks < 2 ? 4 : 2);
+		for (auto q = chunk.begin_pos(), q_last = chunk.end_pos(); q != q_last; chunk.increment_pos(q))
+			BOOST_CHECK_EQUAL(chunk.at_pos(q), value++);
+		++chunks;
+	}
+
+	BOOST_CHECK_EQUAL(chunks, 3);
+	BOOST_CHECK_EQUAL(value, 10);
+	BOOST_CHECK_THROW(make_range(first, last) >> chunk(0), domain_error);
+	BOOST_CHECK_THROW(make_range(first, last) >> chunk(-4), domain_error);
+}
+DEFINE_FORWARD_TESTS(chunk_test)
+
+template <typename Iterator>
+void chunk_random_access_test(Iterator first, Iterator last)
+{
+	auto range = make_range(first, last) >> chunk(4);
+	BOOST_CHECK_EQUAL(length(range), 3);
+	auto p = range.begin_pos();
+	range.advance_pos(p, 1);
+	BOOST_CHECK_EQUAL(front(range.at_pos(p)), 4);
+	auto last_chunk = back(range);
+	BOOST_CHECK_EQUAL(length(last_chunk), 2);
+	BOOST_CHECK_EQUAL(front(last_chunk), 8);
+}
+DEFINE_RANDOM_ACCESS_TESTS(chunk_random_access_test)
+
+template <typename Iterator>
+void sliding_test(Iterator first, Iterator last)
+{
+	auto range = make_range(first, last) >> sliding(3);
+	int value = 0;
+	for (auto p = range.begin_pos(), p_last = range.end_pos(); p != p_last; range.increment_pos(p))
+	{
+		auto window = range.at_pos(p);
+		int values[] = { value, value + 1, value + 2 };
+		BOOST_CHECK(equal(window, make_range(values)));
+		++value;
+	}
+
+	BOOST_CHECK_EQUAL(value, 8);
+	BOOST_CHECK(stdext::empty(make_range(first, last) >> sliding(11)));
+	BOOST_CHECK_THROW(make_range(first, last) >> sliding(0), domain_error);
+}
+DEFINE_FORWARD_TESTS(sliding_test)
+
+template <typename Iterator>
+void sliding_random_access_test(Iterator first, Iterator last)
+{
+	auto range = make_range(first, last) >> sliding(4);
+	BOOST_CHECK_EQUAL(length(range), 7);
+	BOOST_CHECK_EQUAL(front(back(range)), 6);
+	auto p = range.begin_pos();
+	range.advance_pos(p, 3);
+	BOOST_CHECK_EQUAL(back(range.at_pos(p)), 6);
+}
+DEFINE_RANDOM_ACCESS_TESTS(sliding_random_access_test)
+
+template <typename Iterator>
+void window_aggregate_test(Iterator first, Iterator last)
+{
+	int sums[] = { 3, 6, 9, 12, 15, 18, 21, 24 };
+	BOOST_CHECK(equal(make_range(first, last) >> window_aggregate(3, rolling_sum<int>()), make_range(sums)));
+	int maxima[] = { 2, 3, 4, 5, 6, 7, 8, 9 };
+	BOOST_CHECK(equal(make_range(first, last) >> window_aggregate(3, rolling_max<int>()), make_range(maxima)));
+}
+DEFINE_FORWARD_TESTS(window_aggregate_test)
+
+BOOST_AUTO_TEST_CASE(window_aggregate_min_test)
+{
+	int values[] = { 5, 3, 3, 8, 1, 7, 7, 2, 9 };
+	int minima[] = { 3, 3, 1, 1, 1, 2, 2 };
+	BOOST_CHECK(equal(make_range(values) >> window_aggregate(3, rolling_min<int>()), make_range(minima)));
+	double means[] = { 4.75, 3.75, 4.75, 5.75, 4.25, 6.25 };
+	BOOST_CHECK(equal(make_range(values) >> window_aggregate(4, rolling_mean<int>()), make_range(means)));
+	BOOST_CHECK_THROW(make_range(values) >> window_aggregate(-1, rolling_sum<int>()), domain_error);
+}
+
+BOOST_AUTO_TEST_CASE(merge_all_test)
+{
+	int a[] = { 1, 4, 7, 10 };
+	int b[] = { 2, 5, 8 };
+	int c[] = { 0, 3, 6, 9, 11, 12 };
+	int merged[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+	BOOST_CHECK(equal(merge_all(make_range(a), make_range(b), make_range(c)), make_range(merged)));
+
+	std::vector<std::vector<int>> shards(5);
+	for (int i = 0; i != 40; ++i)
+		shards[i * 7 % 5].push_back(i);
+	std::vector<iterator_range<std::vector<int>::const_iterator>> ranges;
+	for (const auto& shard : shards)
+		ranges.push_back(make_range(shard.cbegin(), shard.cend()));
+	std::vector<int> all;
+	for (int n : merge_all(ranges))
+		all.push_back(n);
+	BOOST_CHECK_EQUAL(all.size(), 40u);
+	BOOST_CHECK(std::is_sorted(all.begin(), all.end()));
+
+	BOOST_CHECK(stdext::empty(merge_all(std::vector<iterator_range<int*>>())));
+	int descending[] = { 9, 5, 1 };
+	int four[] = { 4 };
+	int merged_descending[] = { 9, 5, 4, 1 };
+	std::vector<iterator_range<int*>> descending_ranges = { make_range(descending), make_range(four, four), make_range(four) };
+	BOOST_CHECK(equal(merge_all(descending_ranges, std::greater<>()), make_range(merged_descending)));
+}
+
+BOOST_AUTO_TEST_CASE(set_operation_test)
+{
+	int a[] = { 1, 2, 2, 3, 5, 8, 13 };
+	int b[] = { 2, 3, 4, 8, 8, 9 };
+	int c[] = { 3, 13 };
+
+	int unified[] = { 1, 2, 2, 3, 4, 5, 8, 8, 9, 13 };
+	BOOST_CHECK(equal(make_range(a) >> union_with(make_range(b)), make_range(unified)));
+	int intersection[] = { 2, 3, 8 };
+	BOOST_CHECK(equal(make_range(a) >> intersect_with(make_range(b)), make_range(intersection)));
+	int difference[] = { 1, 2, 5, 13 };
+	BOOST_CHECK(equal(make_range(a) >> difference_with(make_range(b)), make_range(difference)));
+	int symmetric_difference[] = { 1, 2, 4, 5, 8, 9, 13 };
+	BOOST_CHECK(equal(make_range(a) >> symmetric_difference_with(make_range(b)), make_range(symmetric_difference)));
+
+	auto query = make_range(a) >> union_with(make_range(b)) >> difference_with(make_range(c));
+	BOOST_CHECK_EQUAL(length(query), 8);
+	BOOST_CHECK_EQUAL(front(query), 1);
+	BOOST_CHECK(stdext::empty(make_range(c) >> intersect_with(make_range(b, b + 1))));
+
+	int descending[] = { 13, 8, 5 };
+	int greater_intersection[] = { 13 };
+	BOOST_CHECK(equal(make_range(descending) >> intersect_with(make_range(c) >> reverse(), std::greater<>()), make_range(greater_intersection)));
+}
+
+template <typename Iterator>
+void top_k_test(Iterator first, Iterator last)
+{
+	auto n = static_cast<int>(distance(first, last));
+	int largest[] = { n - 1, n - 2, n - 3 };
+	BOOST_CHECK(equal(make_range(first, last) >> top_k(3, std::greater<>()), make_range(largest)));
+	int smallest[] = { 0, 1 };
+	BOOST_CHECK(equal(make_range(first, last) >> top_k(2), make_range(smallest)));
+	BOOST_CHECK_EQUAL(length(make_range(first, last) >> top_k(n + 5)), n);
+	BOOST_CHECK(stdext::empty(make_range(first, last) >> top_k(0)));
+}
+DEFINE_INPUT_TESTS(top_k_test)
+
+BOOST_AUTO_TEST_CASE(top_k_filter_test)
+{
+	std::vector<int> scores(10000);
+	for (std::size_t i = 0; i != scores.size(); ++i)
+		scores[i] = static_cast<int>(i * 7919 % 10007) - 5000;
+	auto sorted = scores;
+	std::sort(sorted.begin(), sorted.end(), std::greater<>());
+
+	auto scored = make_range(scores.data(), scores.data() + scores.size());
+	auto best = scored >> top_k(100, std::greater<>());
+	BOOST_CHECK(std::equal(stdext::begin(best), stdext::end(best), sorted.begin(), sorted.begin() + 100));
+	auto worst = scored >> top_k(100);
+	BOOST_CHECK(std::equal(stdext::begin(worst), stdext::end(worst), sorted.rbegin(), sorted.rbegin() + 100));
+
+	std::vector<std::string> words = { "cherry", "fig", "apple", "kiwi", "banana" };
+	std::string shortest[] = { "fig", "kiwi", "apple" };
+	auto by_length = [](const std::string& a, const std::string& b) { return a.size() < b.size(); };
+	BOOST_CHECK(equal(make_range(words) >> top_k(3, by_length), make_range(shortest)));
+}
+
+BOOST_AUTO_TEST_CASE(group_aggregate_test)
+{
+	typedef std::pair<std::string, int> sale;
+	std::vector<sale> sales = { { "pear", 3 }, { "fig", 7 }, { "pear", 1 }, { "kiwi", 4 }, { "fig", 2 }, { "pear", 5 } };
+	auto item = [](const sale& s) { return s.first; };
+	auto amount = [](const sale& s) { return s.second; };
+	auto groups = group_aggregate(make_range(sales), item, group_count(), group_sum(amount), group_min(amount), group_max(amount),
+		group_fold(std::string(), [](std::string digits, const sale& s) { return digits + std::to_string(s.second); }));
+
+	typedef std::tuple<std::string, std::size_t, int, int, int, std::string> row;
+	std::vector<row> rows(stdext::begin(groups), stdext::end(groups));
+	std::sort(rows.begin(), rows.end());
+	std::vector<row> expected = { row("fig", 2, 9, 2, 7, "72"), row("kiwi", 1, 4, 4, 4, "4"), row("pear", 3, 9, 1, 5, "315") };
+	BOOST_CHECK(rows == expected);
+	BOOST_CHECK(stdext::empty(group_aggregate(make_range(sales.data(), sales.data()), item, group_count())));
+}
+
+BOOST_AUTO_TEST_CASE(group_aggregate_spill_test)
+{
+	std::vector<std::uint64_t> ids(50000);
+	for (std::size_t i = 0; i != ids.size(); ++i)
+		ids[i] = (i * 7919 % 10007) << 24;
+	auto id = [](std::uint64_t x) { return x; };
+	auto low = [](std::uint64_t x) { return x >> 24; };
+	auto in_memory = group_aggregate(make_range(ids), id, group_count(), group_sum(low));
+	std::vector<std::tuple<std::uint64_t, std::size_t, std::uint64_t>> expected(stdext::begin(in_memory), stdext::end(in_memory));
+	std::sort(expected.begin(), expected.end());
+	BOOST_CHECK_EQUAL(expected.size(), 10007u);
+
+	static unsigned char memory[4096];
+	scratch_buffer scratch(memory, sizeof(memory));
+	auto spilled = group_aggregate(make_range(ids), id, scratch, group_count(), group_sum(low));
+	std::vector<std::tuple<std::uint64_t, std::size_t, std::uint64_t>> rows(stdext::begin(spilled), stdext::end(spilled));
+	std::sort(rows.begin(), rows.end());
+	BOOST_CHECK(rows == expected);
+
+	auto parallel = parallel_group_aggregate(make_range(ids), id, group_count(), group_sum(low));
+	rows.assign(stdext::begin(parallel), stdext::end(parallel));
+	std::sort(rows.begin(), rows.end());
+	BOOST_CHECK(rows == expected);
+
+	// The input is too short for parallel_group_aggregate to partition it, so check the
+	// partitioned path directly, with more workers than the machine may have.
+	for (unsigned workers : { 1u, 3u })
+	{
+		rows = detail::partitioned_group_aggregate(make_range(ids), id, std::make_tuple(group_count(), group_sum(low)), workers);
+		std::sort(rows.begin(), rows.end());
+		BOOST_CHECK(rows == expected);
+	}
+
+	// Elements that are not trivially copyable are partitioned by index rather than copied.
+	std::vector<std::string> names(ids.size());
+	std::transform(ids.begin(), ids.end(), names.begin(), [](std::uint64_t x) { return std::to_string(x); });
+	auto name = [](const std::string& s) { return s; };
+	auto name_rows = detail::partitioned_group_aggregate(make_range(names), name,
+		std::make_tuple(group_count(), group_sum([](const std::string& s) { return std::stoull(s) >> 24; })), 3);
+	rows.clear();
+	for (auto& row : name_rows)
+		rows.emplace_back(std::stoull(std::get<0>(row)), std::get<1>(row), std::get<2>(row));
+	std::sort(rows.begin(), rows.end());
+	BOOST_CHECK(rows == expected);
+}
+
+template <typename Iterator>
+void group_by_key_test(Iterator first, Iterator last)
+{
+	auto groups = make_range(first, last) >> group_by_key([](int x) { return x / 3; });
+	int value = 0, count = 0;
+	for (auto p = groups.begin_pos(), p_last = groups.end_pos(); p != p_last; groups.increment_pos(p))
+	{
+		auto group = groups.at_pos(p);
+		BOOST_CHECK_EQUAL(length(group), count < 3 ? 3 : 1);
+		for (auto q = group.begin_pos(), q_last = group.end_pos(); q != q_last; group.increment_pos(q))
+			BOOST_CHECK_EQUAL(group.at_pos(q), value++);
+		++count;
+	}
+
+	BOOST_CHECK_EQUAL(count, 4);
+	BOOST_CHECK_EQUAL(length(groups), 4);
+
+	auto sums = make_range(first, last) >> group_by_key([](int x) { return x / 3; }) >> reduce_groups(group_sum([](int x) { return x; }));
+	vector<int> expected = { 3, 12, 21, 9 };
+	BOOST_CHECK(std::equal(RANGE(expected), stdext::begin(sums), stdext::end(sums)));
+}
+
+DEFINE_FORWARD_TESTS(group_by_key_test)
+
+template <typename Iterator>
+void chunk_by_reverse_test(Iterator first, Iterator last)
+{
+	auto groups = make_range(first, last) >> chunk_by([](int, int b) { return b % 4 != 0; });
+	vector<int> lengths;
+	for (auto p = groups.end_pos(), p_first = groups.begin_pos(); p != p_first; )
+		lengths.push_back(int(length(groups.at_pos(groups.decrement_pos(p)))));
+
+	vector<int> expected = { 2, 4, 4 };
+	BOOST_CHECK(lengths == expected);
+	BOOST_CHECK_EQUAL(front(back(groups)), 8);
+}
+
+DEFINE_BIDIRECTIONAL_TESTS(chunk_by_reverse_test)
+
+BOOST_AUTO_TEST_CASE(chunk_by_test)
+{
+	vector<int> values = { 1, 2, 3, 7, 8, 10, 12, 13 };
+	auto runs = make_range(values) >> chunk_by([](int a, int b) { return b == a + 1; }) >> reduce_groups(group_count());
+	vector<size_t> lengths(stdext::begin(runs), stdext::end(runs));
+	vector<size_t> expected = { 3, 2, 1, 2 };
+	BOOST_CHECK(lengths == expected);
+
+	vector<int> none;
+	BOOST_CHECK(stdext::empty(make_range(none) >> chunk_by([](int a, int b) { return a == b; })));
+
+	auto last = make_range(values) >> group_by_key([](int x) { return x / 5; }) >> reduce_groups(group_fold(0, [](int n, int x) { return n * 100 + x; }));
+	vector<int> folds(stdext::begin(last), stdext::end(last));
+	vector<int> expected_folds = { 10203, 708, 101213 };
+	BOOST_CHECK(folds == expected_folds);
+}
+
+template <typename Iterator>
+void join_hash_test(Iterator first, Iterator last)
+{
+	vector<pair<int, char>> build = { { 3, 'a' }, { 12, 'b' }, { 0, 'c' }, { 3, 'd' }, { 9, 'e' } };
+	auto joined = join_hash(make_range(build), make_range(first, last), [](const pair<int, char>& b) { return b.first; }, [](int x) { return x; });
+	string tags;
+	int probes = 0;
+	for (auto p = joined.begin_pos(), p_last = joined.end_pos(); p != p_last; joined.increment_pos(p))
+	{
+		auto row = joined.at_pos(p);
+		BOOST_CHECK_EQUAL(get<0>(row).first, get<1>(row));
+		tags += get<0>(row).second;
+		probes += get<1>(row);
+	}
+
+	BOOST_CHECK_EQUAL(tags, "cade");
+	BOOST_CHECK_EQUAL(probes, 15);
+}
+
+DEFINE_INPUT_TESTS(join_hash_test)
+
+BOOST_AUTO_TEST_CASE(join_hash_update_test)
+{
+	vector<pair<int, int>> prices = { { 1, 10 }, { 2, 20 }, { 4, 40 } };
+	vector<pair<int, int>> orders = { { 4, 0 }, { 3, 0 }, { 1, 0 }, { 4, 0 } };
+	auto first = [](const pair<int, int>& p) { return p.first; };
+	auto joined = join_hash(make_range(prices), make_range(orders), first, first);
+	BOOST_CHECK_EQUAL(length(joined), 3);
+	for (auto p = joined.begin_pos(), p_last = joined.end_pos(); p != p_last; joined.increment_pos(p))
+		get<1>(joined.at_pos(p)).second = get<0>(joined.at_pos(p)).second;
+
+	vector<pair<int, int>> expected = { { 4, 40 }, { 3, 0 }, { 1, 10 }, { 4, 40 } };
+	BOOST_CHECK(orders == expected);
+
+	vector<pair<int, int>> none;
+	BOOST_CHECK(stdext::empty(join_hash(make_range(none), make_range(orders), first, first)));
+	BOOST_CHECK(stdext::empty(join_hash(make_range(prices), make_range(none), first, first)));
+}
+
+template <typename Iterator>
+void join_merge_test(Iterator first, Iterator last)
+{
+	vector<int> other = { -1, 2, 2, 5, 9, 9, 20 };
+	auto joined = join_merge(make_range(first, last), make_range(other), [](int x) { return x; }, [](int x) { return x; });
+	vector<int> keys;
+	for (auto p = joined.begin_pos(), p_last = joined.end_pos(); p != p_last; joined.increment_pos(p))
+	{
+		BOOST_CHECK_EQUAL(get<0>(joined.at_pos(p)), get<1>(joined.at_pos(p)));
+		keys.push_back(get<0>(joined.at_pos(p)));
+	}
+
+	vector<int> expected = { 2, 2, 5, 9, 9 };
+	BOOST_CHECK(keys == expected);
+}
+
+DEFINE_FORWARD_TESTS(join_merge_test)
+
+BOOST_AUTO_TEST_CASE(join_merge_duplicates_test)
+{
+	typedef pair<int, int> row;
+	auto key = [](const row& r) { return r.first; };
+	vector<vector<row>> sides(2);
+	for (int skew : { 1, 40 })
+	{
+		for (int side = 0; side != 2; ++side)
+		{
+			sides[side].clear();
+			for (int i = 0; i != (side == 0 ? 50 : 50 * skew); ++i)
+				sides[side].push_back({ (i * (side == 0 ? 7 : 3)) % (side == 0 ? 200 : 60 * skew) / 2, i });
+			sort(RANGE(sides[side]));
+		}
+
+		vector<pair<int, int>> expected;
+		for (auto& a : sides[0])
+			for (auto& b : sides[1])
+				if (a.first == b.first)
+					expected.push_back({ a.second, b.second });
+
+		vector<pair<int, int>> pairs;
+		auto joined = join_merge(make_range(sides[0]), make_range(sides[1]), key, key);
+		for (auto p = joined.begin_pos(), p_last = joined.end_pos(); p != p_last; joined.increment_pos(p))
+			pairs.push_back({ get<0>(joined.at_pos(p)).second, get<1>(joined.at_pos(p)).second });
+		BOOST_CHECK(!expected.empty());
+		BOOST_CHECK(pairs == expected);
+
+		auto reversed = join_merge(make_range(sides[1]), make_range(sides[0]), key, key);
+		BOOST_CHECK_EQUAL(length(reversed), ptrdiff_t(expected.size()));
+	}
+}
+
+template <typename Iterator>
+void semi_join_filter_test(Iterator first, Iterator last)
+{
+	vector<int> keys = { 1, 4, 5, 8, 100 };
+	auto filter = make_bloom_filter(make_range(keys));
+	vector<int> kept;
+	auto r = make_range(first, last) >> semi_join_filter(filter);
+	for (auto p = r.begin_pos(), p_last = r.end_pos(); p != p_last; r.increment_pos(p))
+		kept.push_back(r.at_pos(p));
+
+	// Keys that were not inserted may pass, but inserted keys always do.
+	BOOST_CHECK(std::includes(RANGE(kept), keys.begin(), keys.end() - 1));
+	BOOST_CHECK(kept.size() < 10);
+}
+
+DEFINE_INPUT_TESTS(semi_join_filter_test)
+
+BOOST_AUTO_TEST_CASE(bloom_filter_test)
+{
+	typedef pair<uint64_t, int> row;
+	vector<row> build(20000);
+	for (size_t i = 0; i != build.size(); ++i)
+		build[i] = { i * 2654435761u, int(i) };
+	auto key = [](const row& r) { return r.first; };
+	auto filter = make_bloom_filter(make_range(build), key);
+	for (auto& r : build)
+		BOOST_CHECK(filter.may_contain(r.first));
+
+	size_t passed = 0, probes = 200000;
+	for (size_t i = 0; i != probes; ++i)
+		passed += filter.may_contain(i * 2654435761u + 1);
+	BOOST_CHECK_LT(passed, probes / 50);
+
+	// The batched probe gives the same answers as probing key by key.
+	vector<uint64_t> keys;
+	for (size_t i = 0; i != 1000; ++i)
+		keys.push_back(i % 3 == 0 ? build[i * 7].first : i * 2654435761u + 1);
+	vector<bool> answers;
+	filter.may_contain(make_range(keys), back_inserter(answers));
+	BOOST_REQUIRE_EQUAL(answers.size(), keys.size());
+	for (size_t i = 0; i != keys.size(); ++i)
+		BOOST_CHECK_EQUAL(answers[i], filter.may_contain(keys[i]));
+	keys.clear();
+	BOOST_CHECK(filter.may_contain(make_range(keys), answers.begin()) == answers.begin());
+
+	// Copies land at other offsets from a 64-byte boundary, and must still find every key.
+	vector<vector<uint64_t>> padding;
+	vector<bloom_filter<uint64_t>> copies;
+	for (size_t i = 0; i != 8; ++i)
+	{
+		padding.emplace_back(i + 1);
+		copies.push_back(filter);
+		padding.emplace_back(i + 1);
+		copies.emplace_back();
+		copies.back() = filter;
+	}
+	for (auto& copy : copies)
+		BOOST_CHECK(std::all_of(build.begin(), build.end(), [&](const row& r) { return copy.may_contain(r.first); }));
+
+	vector<row> probe = { { 2654435761u, 0 }, { 7, 0 }, { 3 * 2654435761ull, 0 } };
+	auto semi = make_range(probe) >> semi_join_filter(filter, key);
+	BOOST_CHECK_EQUAL(front(semi).first, 2654435761u);
+	BOOST_CHECK(std::distance(stdext::begin(semi), stdext::end(semi)) >= 2);
+
+	bloom_filter<uint64_t> empty;
+	BOOST_CHECK(!empty.may_contain(0));
+	BOOST_CHECK(stdext::empty(make_range(probe) >> semi_join_filter(empty, key)));
+}
\ No newline at end of file
@@ -0,0 +1,741 @@
+#include "fixture.h"
+
+#include <adapter.h>
+#include <algorithm.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+#define RANGE(c) begin(c), end(c)
+
+using namespace std;
+using namespace stdext;
+
+namespace
+{
+	size_t allocations = 0;
+}
+
+// Counts heap allocations, so that tests can check that an algorithm made none.  Every form of
+// the allocation functions is replaced, so that all of them agree on malloc and free; GCC, which
+// inlines them, would otherwise warn that memory from operator new is given to free.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new (size_t size, const nothrow_t&) noexcept
+{
+	++allocations;
+	return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new (size_t size)
+{
+	if (void* p = operator new(size, nothrow))
+		return p;
+	throw bad_alloc();
+}
+
+void* operator new[] (size_t size)                            { return operator new(size); }
+void* operator new[] (size_t size, const nothrow_t&) noexcept { return operator new(size, nothrow); }
+void operator delete (void* p) noexcept                       { free(p); }
+void operator delete (void* p, size_t) noexcept               { free(p); }
+void operator delete (void* p, const nothrow_t&) noexcept     { free(p); }
+void operator delete[] (void* p) noexcept                     { free(p); }
+void operator delete[] (void* p, size_t) noexcept             { free(p); }
+void operator delete[] (void* p, const nothrow_t&) noexcept   { free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+	template <class T>
+	vector<T> multiples(T step, T count)
+	{
+		vector<T> v;
+		for (T n = 0; n != count; ++n)
+			v.push_back(n * step);
+		return v;
+	}
+}
+
+BOOST_AUTO_TEST_CASE(set_intersection_test)
+{
+	auto small = vector<int64_t> { 3, 30, 30, 31, 300, 3000, 9999 };
+	auto large = multiples<int64_t>(3, 3000);
+	vector<int64_t> expected, actual;
+	std::set_intersection(RANGE(small), RANGE(large), back_inserter(expected));
+
+	stdext::set_intersection(make_range(small), make_range(large), back_inserter(actual));
+	BOOST_CHECK(actual == expected);
+	actual.clear();
+	stdext::set_intersection(make_range(large), make_range(small), back_inserter(actual));
+	BOOST_CHECK(actual == expected);
+
+	auto a = multiples<uint32_t>(2, 1000), b = multiples<uint32_t>(3, 700);
+	vector<uint32_t> expected32, actual32;
+	std::set_intersection(RANGE(a), RANGE(b), back_inserter(expected32));
+	stdext::set_intersection(make_range(a.data(), a.data() + a.size()), make_range(b.data(), b.data() + b.size()), back_inserter(actual32));
+	BOOST_CHECK_EQUAL(actual32.size(), 334u);
+	BOOST_CHECK(actual32 == expected32);
+
+	// Blocks are compared all pairs at once only when neither range repeats a value; repeated
+	// values must still match as often as in the shorter run.
+	mt19937 engine(5);
+	for (int repeats : { 0, 1 })
+	{
+		vector<int64_t> c, d;
+		for (int i = 0; i != 1003; ++i)
+			c.push_back(int64_t(engine() % 3000) - 1500);
+		for (int i = 0; i != 2001; ++i)
+			d.push_back(int64_t(engine() % 3000) - 1500);
+		std::sort(RANGE(c));
+		std::sort(RANGE(d));
+		if (!repeats)
+		{
+			c.erase(std::unique(RANGE(c)), c.end());
+			d.erase(std::unique(RANGE(d)), d.end());
+		}
+		vector<int64_t> expected64, actual64;
+		std::set_intersection(RANGE(c), RANGE(d), back_inserter(expected64));
+		stdext::set_intersection(make_range(c.data(), c.data() + c.size()), make_range(d.data(), d.data() + d.size()), back_inserter(actual64));
+		BOOST_CHECK(actual64 == expected64);
+
+		vector<int32_t> c32(RANGE(c)), d32(RANGE(d)), expected32s, actual32s;
+		std::set_intersection(RANGE(d32), RANGE(c32), back_inserter(expected32s));
+		stdext::set_intersection(make_range(d32.data(), d32.data() + d32.size()), make_range(c32.data(), c32.data() + c32.size()), back_inserter(actual32s));
+		BOOST_CHECK(actual32s == expected32s);
+	}
+
+	list<int> la = { 1, 2, 2, 4, 6 }, lb = { 2, 2, 2, 6 };
+	vector<int> actual_list;
+	stdext::set_intersection(make_range(la), make_range(lb), back_inserter(actual_list));
+	BOOST_CHECK((actual_list == vector<int> { 2, 2, 6 }));
+
+	actual.clear();
+	auto descending = vector<int64_t>(large.rbegin(), large.rend());
+	auto needles = vector<int64_t> { 9000, 2997 };
+	stdext::set_intersection(make_range(descending), make_range(needles), back_inserter(actual), greater<>());
+	BOOST_CHECK((actual == vector<int64_t> { 2997 }));
+}
+
+BOOST_AUTO_TEST_CASE(includes_test)
+{
+	auto large = multiples<int>(5, 2000);
+	auto present = vector<int> { 0, 5, 500, 9995 }, absent = vector<int> { 0, 5, 501 }, repeated = vector<int> { 5, 5 };
+	BOOST_CHECK(stdext::includes(make_range(large), make_range(present)));
+	BOOST_CHECK(!stdext::includes(make_range(large), make_range(absent)));
+	BOOST_CHECK(!stdext::includes(make_range(large), make_range(repeated)));
+	BOOST_CHECK(stdext::includes(make_range(large), make_range(large)));
+
+	list<int> l = { 1, 3, 5 };
+	auto tail = vector<int> { 3, 5 };
+	BOOST_CHECK(stdext::includes(make_range(l), make_range(tail)));
+}
+
+BOOST_AUTO_TEST_CASE(radix_sort_test)
+{
+	mt19937 engine(7);
+	vector<int64_t> ids(20000);
+	for (auto& id : ids)
+		id = static_cast<int64_t>(engine()) - (1ll << 31) + (static_cast<int64_t>(engine()) << 32);
+	auto expected = ids;
+	std::sort(RANGE(expected));
+
+	auto copy = ids;
+	radix_sort(make_range(copy));
+	BOOST_CHECK(copy == expected);
+	copy = ids;
+	parallel_radix_sort(make_range(copy));
+	BOOST_CHECK(copy == expected);
+	copy = ids;
+	stdext::sort(make_range(copy.data(), copy.data() + copy.size()));
+	BOOST_CHECK(copy == expected);
+
+	vector<double> reals = { 2.5, -0.5, 1e300, -1e-300, 0.0, -7.0, 3.0 };
+	radix_sort(make_range(reals));
+	BOOST_CHECK(std::is_sorted(RANGE(reals)));
+
+	// One non-trivial pass, so the sorted values end up in the scratch buffer.
+	vector<uint32_t> bytes(10000);
+	for (auto& b : bytes)
+		b = engine() & 0xFF;
+	auto sorted_bytes = bytes;
+	std::sort(RANGE(sorted_bytes));
+	stdext::sort(make_range(bytes));
+	BOOST_CHECK(bytes == sorted_bytes);
+
+	// long double has no radix key, so it is comparison sorted.
+	vector<long double> extended(5000);
+	for (auto& x : extended)
+		x = static_cast<long double>(engine()) - (1u << 31);
+	stdext::sort(make_range(extended));
+	BOOST_CHECK(std::is_sorted(RANGE(extended)));
+
+	vector<pair<unsigned short, int>> records = { { 3, 0 }, { 1, 1 }, { 3, 2 }, { 0, 3 }, { 1, 4 } };
+	radix_sort(make_range(records), [](const pair<unsigned short, int>& r) { return r.first; });
+	vector<int> order;
+	for (const auto& r : records)
+		order.push_back(r.second);
+	BOOST_CHECK((order == vector<int> { 3, 1, 4, 0, 2 }));
+}
+
+BOOST_AUTO_TEST_CASE(string_sort_test)
+{
+	vector<string> urls = {
+		"http://example.com/b", "http://example.com/a/2", "http://example.com/a", "", "http://example.org",
+		"http://example.com/a/10", "https://example.com", "http://example.com/a", "h",
+	};
+	for (int i = 0; i != 100; ++i)
+		urls.push_back("http://example.com/page/" + to_string(i * 37 % 100));
+	auto expected = urls;
+	std::sort(RANGE(expected));
+	string_sort(make_range(urls));
+	BOOST_CHECK(urls == expected);
+
+	const char text[] = "pear,apple,peach,apple,fig,pea";
+	vector<iterator_range<const char*>> words;
+	auto tokens = make_range(text, text + sizeof(text) - 1) >> split(',');
+	for (auto p = tokens.begin_pos(), last = tokens.end_pos(); p != last; tokens.increment_pos(p))
+		words.push_back(tokens.at_pos(p));
+	string_sort(make_range(words));
+	vector<string> sorted_words;
+	for (const auto& w : words)
+		sorted_words.push_back(string(w.begin_pos(), w.end_pos()));
+	BOOST_CHECK((sorted_words == vector<string> { "apple", "apple", "fig", "pea", "peach", "pear" }));
+
+	vector<string> keys = { "b", "c", "a" };
+	vector<int> values = { 2, 3, 1 };
+	string_sort(zip(make_range(keys), make_range(values)), [](const auto& r) -> const string& { return get<0>(r); });
+	BOOST_CHECK((keys == vector<string> { "a", "b", "c" }));
+	BOOST_CHECK((values == vector<int> { 1, 2, 3 }));
+}
+
+BOOST_AUTO_TEST_CASE(sort_patterns_test)
+{
+	const int n = 3000;
+	vector<vector<int>> inputs;
+	vector<int> v(n);
+	iota(RANGE(v), 0);
+	inputs.push_back(v);
+	inputs.push_back(vector<int>(v.rbegin(), v.rend()));
+	for (int i = 0; i != n; ++i)
+		v[i] = i % 100;
+	inputs.push_back(v);
+	for (int i = 0; i != n; ++i)
+		v[i] = i * 7919 % 5;
+	inputs.push_back(v);
+	iota(RANGE(v), 0);
+	for (int i = n - 50; i != n; ++i)
+		v[i] = (i * 31) % n;
+	inputs.push_back(v);
+	mt19937 engine(3);
+	for (auto& x : v)
+		x = engine() % 1000000;
+	inputs.push_back(v);
+
+	for (auto input : inputs)
+	{
+		auto expected = input;
+		std::sort(RANGE(expected));
+		auto copy = input;
+		stdext::sort(make_range(copy));
+		BOOST_CHECK(copy == expected);
+		copy = input;
+		stdext::sort(make_range(copy), greater<>());
+		BOOST_CHECK(std::equal(copy.rbegin(), copy.rend(), expected.begin()));
+
+		vector<string> strings;
+		for (int x : input)
+			strings.push_back(to_string(x));
+		auto expected_strings = strings;
+		std::sort(RANGE(expected_strings));
+		stdext::sort(make_range(strings));
+		BOOST_CHECK(strings == expected_strings);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(stable_sort_test)
+{
+	typedef pair<int, int> record;
+	mt19937 engine(11);
+	vector<vector<record>> inputs(4);
+	for (int i = 0; i != 5000; ++i)
+	{
+		inputs[0].push_back({ static_cast<int>(engine() % 50), i });
+		inputs[1].push_back({ i / 3, i });
+		inputs[2].push_back({ (5000 - i) / 7, i });
+		inputs[3].push_back({ i % 700 + (i > 4900 ? static_cast<int>(engine() % 700) : 0), i });
+	}
+
+	auto by_key = [](const record& a, const record& b) { return a.first < b.first; };
+	for (const auto& input : inputs)
+	{
+		auto expected = input;
+		std::stable_sort(RANGE(expected), by_key);
+
+		auto copy = input;
+		stdext::stable_sort(make_range(copy), by_key);
+		BOOST_CHECK(copy == expected);
+
+		for (size_t scratch_size : { size_t(0), size_t(10), input.size() / 2 })
+		{
+			vector<record> scratch(scratch_size);
+			copy = input;
+			stdext::stable_sort(make_range(copy), by_key, make_range(scratch));
+			BOOST_CHECK(copy == expected);
+		}
+	}
+
+	// Move-only and not default constructible: merged through a buffer all the same.
+	struct keyed
+	{
+		keyed(int key, int index) : key(key), index(new int(index)) { }
+		int key;
+		unique_ptr<int> index;
+	};
+	vector<keyed> moveable;
+	for (const auto& r : inputs[0])
+		moveable.emplace_back(r.first, r.second);
+	stdext::stable_sort(make_range(moveable), [](const keyed& a, const keyed& b) { return a.key < b.key; });
+	auto expected = inputs[0];
+	std::stable_sort(RANGE(expected), by_key);
+	BOOST_CHECK(std::equal(RANGE(moveable), expected.begin(), [](const keyed& a, const record& b) { return a.key == b.first && *a.index == b.second; }));
+}
+
+BOOST_AUTO_TEST_CASE(scratch_buffer_test)
+{
+	typedef pair<int, int> record;
+	auto by_key = [](const record& a, const record& b) { return a.first < b.first; };
+	mt19937 engine(5);
+	vector<record> records;
+	for (int i = 0; i != 1000; ++i)
+		records.push_back({ static_cast<int>(engine() % 20), i });
+	auto sorted = records;
+	std::stable_sort(RANGE(sorted), by_key);
+	auto is_even = [](const record& r) { return r.first % 2 == 0; };
+	auto partitioned = records;
+	std::stable_partition(RANGE(partitioned), is_even);
+	auto shuffled = sorted;
+	std::shuffle(RANGE(shuffled), engine);
+	auto halves = records;
+	std::stable_sort(halves.begin(), halves.begin() + 400, by_key);
+	std::stable_sort(halves.begin() + 400, halves.end(), by_key);
+	auto merged = halves;
+	std::inplace_merge(merged.begin(), merged.begin() + 400, merged.end(), by_key);
+
+	static unsigned char large[64 * 1024];
+	static unsigned char small[64];
+	for (auto memory : { make_pair(large, sizeof(large)), make_pair(small, sizeof(small)) })
+	{
+		scratch_buffer scratch(memory.first, memory.second);
+		auto a = records, b = records, c = halves;
+		auto d = vector<int> { 3, 1, 2, 3 }, e = vector<int> { 3, 3, 2, 1 }, f = vector<int> { 3, 1, 2, 2 };
+
+		auto before = allocations;
+		stable_sort(make_range(a), by_key, scratch);
+		auto middle = stable_partition(make_range(b), is_even, scratch);
+		auto c_range = make_range(c);
+		inplace_merge(c_range, c_range.begin_pos() + 400, by_key, scratch);
+		bool same = stdext::is_permutation(make_range(sorted), make_range(shuffled), scratch);
+		bool permutation = stdext::is_permutation(make_range(d), make_range(e), scratch);
+		bool not_permutation = stdext::is_permutation(make_range(d), make_range(f), scratch);
+		auto after = allocations;
+
+		BOOST_CHECK_EQUAL(after, before);
+		BOOST_CHECK(a == sorted);
+		BOOST_CHECK(b == partitioned);
+		BOOST_CHECK(middle - b.begin() == std::partition_point(RANGE(partitioned), is_even) - partitioned.begin());
+		BOOST_CHECK(c == merged);
+		BOOST_CHECK(same);
+		BOOST_CHECK(permutation);
+		BOOST_CHECK(!not_permutation);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(hashed_is_permutation_test)
+{
+	mt19937 engine(11);
+	vector<long long> ids(5000);
+	for (auto& id : ids)
+		id = static_cast<long long>(engine() % 1000) << 32;
+	auto shuffled = ids;
+	std::shuffle(RANGE(shuffled), engine);
+	auto changed = shuffled;
+	changed[1234] += 1;
+
+	static unsigned char large[256 * 1024];
+	static unsigned char small[64];
+	for (auto memory : { make_pair(large, sizeof(large)), make_pair(small, sizeof(small)) })
+	{
+		scratch_buffer scratch(memory.first, memory.second);
+		BOOST_CHECK(stdext::is_permutation(make_range(ids), make_range(shuffled), scratch));
+		BOOST_CHECK(!stdext::is_permutation(make_range(ids), make_range(changed), scratch));
+	}
+
+	scratch_buffer scratch(large, sizeof(large));
+	vector<string> words = { "Fig", "apple", "KIWI", "fig" }, other = { "kiwi", "FIG", "fig", "Apple" };
+	auto lower = [](string s) { for (auto& c : s) c = static_cast<char>(tolower(c)); return s; };
+	auto hash = [&](const string& s) { return std::hash<string>()(lower(s)); };
+	auto eq = [&](const string& a, const string& b) { return lower(a) == lower(b); };
+	BOOST_CHECK(stdext::is_permutation(make_range(words), make_range(other), hash, eq, scratch));
+	BOOST_CHECK(!stdext::is_permutation(make_range(words), make_range(other), scratch));
+	other[2] = "kiwi";
+	BOOST_CHECK(!stdext::is_permutation(make_range(words), make_range(other), hash, eq, scratch));
+
+	// The same answers as the overload without scratch, which compares with ==.
+	vector<double> reals = { 0.0, 1.5, nan("") }, signed_zero = { 1.5, -0.0, nan("") };
+	BOOST_CHECK(!stdext::is_permutation(make_range(reals), make_range(signed_zero), scratch));
+	BOOST_CHECK_EQUAL(stdext::is_permutation(make_range(reals), make_range(signed_zero), scratch),
+					  stdext::is_permutation(make_range(reals), make_range(signed_zero)));
+	reals.pop_back();
+	signed_zero.pop_back();
+	BOOST_CHECK(stdext::is_permutation(make_range(reals), make_range(signed_zero), scratch));
+
+	struct point
+	{
+		int x, y;
+		bool operator == (const point& other) const { return x == other.x && y == other.y; }
+	};
+	vector<point> points = { { 1, 2 }, { 3, 4 }, { 1, 2 } }, moved = { { 3, 4 }, { 1, 2 }, { 1, 2 } };
+	BOOST_CHECK(stdext::is_permutation(make_range(points), make_range(moved), scratch));
+	moved[0].y = 5;
+	BOOST_CHECK(!stdext::is_permutation(make_range(points), make_range(moved), scratch));
+}
+
+BOOST_AUTO_TEST_CASE(sort_by_key_test)
+{
+	struct account
+	{
+		string name;
+		long long balance;
+	};
+
+	vector<account> accounts;
+	for (int i = 0; i != 200; ++i)
+		accounts.push_back({ "account" + to_string(i), (i * 7919) % 50 - 25 });
+
+	int calls = 0;
+	auto balance = [&](const account& a) { ++calls; return a.balance; };
+	auto stable = accounts;
+	stable_sort_by_key(make_range(stable), balance);
+	BOOST_CHECK_EQUAL(calls, 200);
+	auto expected = accounts;
+	std::stable_sort(RANGE(expected), [](const account& a, const account& b) { return a.balance < b.balance; });
+	BOOST_CHECK(std::equal(RANGE(stable), expected.begin(), [](const account& a, const account& b) { return a.name == b.name; }));
+
+	auto by_name = accounts;
+	sort_by_key(make_range(by_name), [](const account& a) { return a.name; }, greater<>());
+	BOOST_CHECK(std::is_sorted(RANGE(by_name), [](const account& a, const account& b) { return a.name > b.name; }));
+
+	auto unstable = accounts;
+	sort_by_key(make_range(unstable), [](const account& a) { return a.balance; });
+	BOOST_CHECK(std::is_sorted(RANGE(unstable), [](const account& a, const account& b) { return a.balance < b.balance; }));
+
+	auto extended = accounts;
+	sort_by_key(make_range(extended), [](const account& a) { return static_cast<long double>(a.balance); });
+	BOOST_CHECK(std::is_sorted(RANGE(extended), [](const account& a, const account& b) { return a.balance < b.balance; }));
+
+	// Enough keys to be radix sorted.
+	vector<account> many;
+	for (int i = 0; i != 10000; ++i)
+		many.push_back({ to_string(i), (i * 7919) % 1000 - 500 });
+	auto many_expected = many;
+	std::stable_sort(RANGE(many_expected), [](const account& a, const account& b) { return a.balance < b.balance; });
+	stable_sort_by_key(make_range(many), [](const account& a) { return a.balance; });
+	BOOST_CHECK(std::equal(RANGE(many), many_expected.begin(), [](const account& a, const account& b) { return a.name == b.name; }));
+}
+
+BOOST_AUTO_TEST_CASE(sort_network_test)
+{
+	mt19937 engine(5);
+	for (int n = 0; n != 40; ++n)
+	{
+		vector<int> input(n);
+		for (auto& x : input)
+			x = engine() % 20 - 10;
+		auto expected = input;
+		std::sort(RANGE(expected));
+
+		auto copy = input;
+		stdext::sort(make_range(copy));
+		BOOST_CHECK(copy == expected);
+		copy = input;
+		stdext::sort(make_range(copy), greater<>());
+		BOOST_CHECK(std::equal(copy.rbegin(), copy.rend(), expected.begin()));
+
+		if (n == 0)
+			continue;
+		auto middle = n / 3;
+		copy = input;
+		auto range = make_range(copy);
+		stdext::partial_sort(range, copy.begin() + middle);
+		BOOST_CHECK(std::equal(copy.begin(), copy.begin() + middle, expected.begin()));
+		copy = input;
+		range = make_range(copy);
+		stdext::nth_element(range, copy.begin() + middle, less<>());
+		BOOST_CHECK_EQUAL(copy[middle], expected[middle]);
+		BOOST_CHECK(std::all_of(copy.begin(), copy.begin() + middle, [&](int x) { return x <= copy[middle]; }));
+		BOOST_CHECK(std::all_of(copy.begin() + middle, copy.end(), [&](int x) { return x >= copy[middle]; }));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(fixed_range_test)
+{
+	int a[13] = { 5, -3, 8, 0, 12, 7, -3, 1, 9, 4, 2, 11, 6 };
+	int b[13];
+	auto fa = make_fixed_range(a);
+	auto fb = make_fixed_range(b);
+	BOOST_CHECK_EQUAL(decltype(fa)::extent, 13u);
+	BOOST_CHECK_EQUAL(length(fa), 13);
+
+	stdext::fill(fb, 4);
+	BOOST_CHECK(std::all_of(RANGE(b), [](int x) { return x == 4; }));
+	BOOST_CHECK(stdext::min_element(fa) == a + 1);
+	BOOST_CHECK(stdext::min_element(fa, greater<>()) == a + 4);
+
+	std::copy(RANGE(a), b);
+	BOOST_CHECK(stdext::equal(fa, fb));
+	b[12] = 0;
+	BOOST_CHECK(!stdext::equal(fa, fb));
+
+	stdext::sort(fa);
+	BOOST_CHECK(std::is_sorted(RANGE(a)));
+	stdext::sort(fa, greater<>());
+	BOOST_CHECK(std::is_sorted(RANGE(a), greater<>()));
+
+	// Narrowed ranges fall back to the general algorithms.
+	fa.begin_pos(a + 2);
+	stdext::sort(fa);
+	BOOST_CHECK(std::is_sorted(a + 2, a + 13));
+	BOOST_CHECK(stdext::min_element(fa) == a + 2);
+
+	array<string, 5> strings = { { "delta", "alpha", "echo", "charlie", "bravo" } };
+	stdext::sort(make_fixed_range(strings));
+	BOOST_CHECK(std::is_sorted(RANGE(strings)));
+	const array<string, 5>& const_strings = strings;
+	BOOST_CHECK(*stdext::min_element(make_fixed_range(const_strings)) == "alpha");
+
+	// Longer arrays are not unrolled.
+	array<int, 100> large;
+	iota(RANGE(large), 0);
+	std::reverse(RANGE(large));
+	stdext::sort(make_fixed_range(large));
+	BOOST_CHECK(std::is_sorted(RANGE(large)));
+	stdext::fill(make_fixed_range(large), 1);
+	BOOST_CHECK_EQUAL(std::accumulate(RANGE(large), 0), 100);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_select_test)
+{
+	const int n = 1 << 19;
+	vector<int> input(n);
+	mt19937 engine(11);
+	for (auto& x : input)
+		x = engine() % 100000;
+	auto expected = input;
+	std::sort(RANGE(expected));
+
+	for (int k : { 0, 100, n / 2, n - 1 })
+	{
+		auto copy = input;
+		auto range = make_range(copy);
+		stdext::parallel_partial_sort(range, copy.begin() + k);
+		BOOST_CHECK(std::equal(copy.begin(), copy.begin() + k, expected.begin()));
+
+		copy = input;
+		range = make_range(copy);
+		stdext::parallel_nth_element(range, copy.begin() + k);
+		BOOST_CHECK_EQUAL(copy[k], expected[k]);
+		BOOST_CHECK(*std::max_element(copy.begin(), copy.begin() + k + 1) == copy[k]);
+		BOOST_CHECK(*std::min_element(copy.begin() + k, copy.end()) == copy[k]);
+	}
+
+	auto copy = input;
+	auto range = make_range(copy);
+	stdext::parallel_partial_sort(range, copy.begin() + 100, greater<>());
+	BOOST_CHECK(std::equal(copy.begin(), copy.begin() + 100, expected.rbegin()));
+
+	// The public functions use as many workers as the machine has threads, so check the
+	// threaded paths directly, with more workers than the machine may have.
+	for (unsigned workers : { 2u, 3u, 7u })
+	{
+		for (int k : { 0, 100, n / 2, n - 1 })
+		{
+			copy = input;
+			stdext::detail::parallel_partial_sort(copy.begin(), copy.begin() + k, copy.end(), less<>(), workers);
+			BOOST_CHECK(std::equal(copy.begin(), copy.begin() + k, expected.begin()));
+
+			copy = input;
+			stdext::detail::parallel_nth_element(copy.begin(), copy.begin() + k, copy.end(), less<>(), workers, true_type());
+			BOOST_CHECK_EQUAL(copy[k], expected[k]);
+			BOOST_CHECK(*std::max_element(copy.begin(), copy.begin() + k + 1) == copy[k]);
+			BOOST_CHECK(*std::min_element(copy.begin() + k, copy.end()) == copy[k]);
+		}
+	}
+}
+
+template <size_t Arity>
+void check_dary_heap(const vector<int>& input)
+{
+	auto values = input;
+	auto range = make_range(values);
+	stdext::make_dary_heap<Arity>(range);
+	BOOST_CHECK(stdext::is_dary_heap<Arity>(range));
+	BOOST_CHECK(values.empty() || values.front() == *std::max_element(input.begin(), input.end()));
+	stdext::sort_dary_heap<Arity>(range);
+	BOOST_CHECK(std::is_sorted(RANGE(values)));
+
+	values.clear();
+	for (int x : input)
+	{
+		values.push_back(x);
+		stdext::push_dary_heap<Arity>(make_range(values), greater<>());
+	}
+	BOOST_CHECK(stdext::is_dary_heap<Arity>(make_range(values), greater<>()));
+	vector<int> popped;
+	while (!values.empty())
+	{
+		stdext::pop_dary_heap<Arity>(make_range(values), greater<>());
+		popped.push_back(values.back());
+		values.pop_back();
+	}
+	auto expected = input;
+	std::sort(expected.begin(), expected.end());
+	BOOST_CHECK(popped == expected);
+}
+
+BOOST_AUTO_TEST_CASE(dary_heap_test)
+{
+	mt19937 engine(13);
+	for (int n : { 0, 1, 2, 5, 17, 1000 })
+	{
+		vector<int> input(n);
+		for (auto& x : input)
+			x = engine() % 100;
+		check_dary_heap<2>(input);
+		check_dary_heap<3>(input);
+		check_dary_heap<4>(input);
+		check_dary_heap<8>(input);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(heap_queue_test)
+{
+	heap_queue<int, 4, greater<>> timers;
+	BOOST_CHECK(timers.empty());
+	for (int t : { 50, 10, 40, 30, 20 })
+		timers.push(t);
+	BOOST_CHECK_EQUAL(timers.top(), 10);
+	timers.pop();
+	BOOST_CHECK_EQUAL(timers.top(), 20);
+
+	vector<int> batch(200);
+	iota(RANGE(batch), 100);
+	std::reverse(RANGE(batch));
+	timers.push_range(make_range(batch));
+	int few[] = { 5, 1 };
+	timers.push_range(make_range(few));
+	BOOST_CHECK_EQUAL(timers.size(), 206u);
+	BOOST_CHECK(stdext::is_dary_heap<4>(timers.elements(), greater<>()));
+
+	vector<int> due;
+	timers.pop_n(6, back_inserter(due));
+	vector<int> expected = { 1, 5, 20, 30, 40, 50 };
+	BOOST_CHECK(due == expected);
+	due.clear();
+	timers.pop_n(1000, back_inserter(due));
+	BOOST_CHECK_EQUAL(due.size(), 200u);
+	BOOST_CHECK(std::is_sorted(RANGE(due)));
+	BOOST_CHECK(timers.empty());
+
+	heap_queue<string, 8> words;
+	words.emplace("pear");
+	words.emplace(3, 'z');
+	words.push("apple");
+	BOOST_CHECK_EQUAL(words.top(), "zzz");
+}
+
+BOOST_AUTO_TEST_CASE(search_index_test)
+{
+	for (int n : { 0, 1, 2, 7, 8, 100, 1023, 1024, 5000 })
+	{
+		vector<int> sorted(n);
+		for (int i = 0; i != n; ++i)
+			sorted[i] = 3 * (i / 2);
+		search_index<int> index(make_range(sorted));
+		BOOST_CHECK_EQUAL(index.size(), static_cast<size_t>(n));
+
+		vector<int> queries;
+		for (int v = -2; v <= 3 * n / 2 + 2; ++v)
+			queries.push_back(v);
+		vector<size_t> expected, batched;
+		for (int v : queries)
+		{
+			expected.push_back(std::lower_bound(RANGE(sorted), v) - sorted.begin());
+			BOOST_CHECK_EQUAL(index.lower_bound(v), expected.back());
+		}
+		index.lower_bound(make_range(queries), back_inserter(batched));
+		BOOST_CHECK(batched == expected);
+	}
+
+	vector<string> names = { "delta", "charlie", "bravo", "alpha" };
+	search_index<string, greater<>> descending(make_range(names), greater<>());
+	BOOST_CHECK_EQUAL(descending.lower_bound("charlie"), 1u);
+	BOOST_CHECK_EQUAL(descending.lower_bound("c"), 2u);
+	BOOST_CHECK_EQUAL(descending.lower_bound("a"), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(lower_bound_test)
+{
+	for (int n : { 0, 1, 2, 3, 10, 64, 1000 })
+	{
+		vector<int> sorted(n);
+		for (int i = 0; i != n; ++i)
+			sorted[i] = 2 * (i / 3);
+		auto range = make_range(sorted);
+		vector<int> descending(sorted.rbegin(), sorted.rend());
+		auto descending_range = make_range(descending);
+		for (int v = -1; v <= 2 * n / 3 + 2; ++v)
+		{
+			BOOST_CHECK(stdext::lower_bound(range, v) == std::lower_bound(RANGE(sorted), v));
+			BOOST_CHECK(stdext::lower_bound(descending_range, v, greater<>()) == std::lower_bound(RANGE(descending), v, greater<>()));
+			BOOST_CHECK(stdext::interpolation_lower_bound(range, v) == std::lower_bound(RANGE(sorted), v));
+		}
+	}
+
+	// Skewed keys exhaust the interpolation probes and fall back to binary search.
+	vector<int64_t> skewed;
+	for (int64_t i = 0; i != 2000; ++i)
+		skewed.push_back(i < 1990 ? i : i * i * i * i);
+	auto skewed_range = make_range(skewed);
+	for (int64_t v : { int64_t(-5), int64_t(0), int64_t(17), int64_t(1989), int64_t(1990), int64_t(1991) * 1991 * 1991 * 1991, int64_t(1) << 60 })
+		BOOST_CHECK(stdext::interpolation_lower_bound(skewed_range, v) == std::lower_bound(RANGE(skewed), v));
+
+	// Infinite ends give no estimate to interpolate from.
+	vector<double> reals(100);
+	iota(reals.begin(), reals.end(), 0.0);
+	reals.front() = -numeric_limits<double>::infinity();
+	reals.back() = numeric_limits<double>::infinity();
+	auto real_range = make_range(reals);
+	for (double v : { -numeric_limits<double>::infinity(), -1.0, 42.5, 98.0, 1e300, numeric_limits<double>::infinity() })
+		BOOST_CHECK(stdext::interpolation_lower_bound(real_range, v) == std::lower_bound(RANGE(reals), v));
+}